@@ -0,0 +1,23 @@
+#include <cancellation.hpp>
+#include <csignal>
+
+
+namespace {
+
+    // Flag cancelled by the signal handler (kept alive while the handler is installed)
+    std::shared_ptr< std::atomic<bool> > signal_flag;
+
+    extern "C" void handle_signal(int signal) {
+        signal_flag->store(true, std::memory_order_relaxed);
+        std::signal(signal, SIG_DFL);
+    }
+
+} // namespace
+
+
+void
+mpp::cancellation_token_t::cancel_on_signals() const {
+    signal_flag = cancelled_;
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+}
@@ -0,0 +1,44 @@
+#ifndef INCLUDE_MPP_CANCELLATION_HPP_
+#define INCLUDE_MPP_CANCELLATION_HPP_
+
+#include <atomic>
+#include <memory>
+
+
+namespace mpp {
+
+    /**
+     * @brief Cooperative cancellation of a solver run.
+     * @details Copies of a token share the same flag, so a host keeps a copy and passes another one to
+     * the solver settings. Once cancelled, the solvers stop at their next check and return the best
+     * solution found so far. All methods are thread-safe.
+     */
+    class cancellation_token_t {
+        public:
+
+        cancellation_token_t() : cancelled_(std::make_shared< std::atomic<bool> >(false)) { }
+
+        /**
+         * @brief Request the cancellation of the runs using this token (or a copy of it).
+         */
+        void cancel() const { cancelled_->store(true, std::memory_order_relaxed); }
+
+        /**
+         * @brief Check whether the cancellation was requested.
+         */
+        bool cancelled() const { return cancelled_->load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Cancel this token on SIGINT or SIGTERM (a second signal terminates the process).
+         * @details Only one token of the process is cancelled by signals (the last one given).
+         */
+        void cancel_on_signals() const;
+
+        private:
+        std::shared_ptr< std::atomic<bool> > cancelled_;
+    };
+
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_CANCELLATION_HPP_
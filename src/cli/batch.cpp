@@ -0,0 +1,340 @@
+#include <cli/cli.hpp>
+#include <cancellation.hpp>
+#include <problem.hpp>
+#include <presolve.hpp>
+#include <reoptimize.hpp>
+#include <stats.hpp>
+#include <trace.hpp>
+#include <thread_pool.hpp>
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cxxopts.hpp>
+#include <cxxtimer.hpp>
+
+
+namespace {
+
+    /**
+     * @brief A job read from the manifest.
+     */
+    struct job_t {
+        std::string instance;
+        std::string output;
+        mpp::solver::differential_evolution_settings_t settings;
+        bool presolve = true;
+        std::string previous;  // Previous version of the instance (optional)
+        std::string error;  // Error parsing the job (the job is skipped if not empty)
+    };
+
+
+    /**
+     * @brief An instance loaded (and presolved) for a job.
+     */
+    struct loaded_instance_t {
+        std::shared_ptr<mpp::problem_t> problem;
+        double load_time = 0.0;
+        std::string error;
+    };
+
+
+    /**
+     * @brief The outcome of a job, reported in the summary.
+     */
+    struct job_result_t {
+        std::string status = "skipped";
+        double objective = 0.0;
+        double mean_risk = 0.0;
+        double expected_excess = 0.0;
+        double exclusions = 0.0;
+        double resource_count = 0.0;
+        double resource_sum = 0.0;
+        double load_time = 0.0;
+        double solve_time = 0.0;
+        std::string error;
+    };
+
+
+    /**
+     * @brief Split a manifest line into arguments (separated by whitespace, double quotes group words).
+     */
+    std::vector<std::string> tokenize(const std::string& line) {
+        std::vector<std::string> tokens;
+        std::string token;
+        bool quoted = false;
+        bool has_token = false;
+        for (char c : line) {
+            if (c == '"') {
+                quoted = !quoted;
+                has_token = true;
+            } else if (!quoted && std::isspace(static_cast<unsigned char>(c))) {
+                if (has_token) tokens.push_back(token);
+                token.clear();
+                has_token = false;
+            } else {
+                token += c;
+                has_token = true;
+            }
+        }
+        if (has_token) tokens.push_back(token);
+        return tokens;
+    }
+
+
+    /**
+     * @brief Parse a manifest line with the options of the solver.
+     */
+    job_t parse_job(const std::vector<std::string>& tokens) {
+        job_t job;
+
+        cxxopts::Options options("job", "Batch job.");
+        options.add_options()
+            ("instance", "Path to the instance file.", cxxopts::value<std::string>())
+            ("output", "Path to the output solution file.", cxxopts::value<std::string>());
+        mpp::cli::add_solve_options(options);
+        options.parse_positional({"instance", "output"});
+
+        std::vector<const char*> argv = { "job" };
+        for (const auto& token : tokens) {
+            argv.push_back(token.c_str());
+        }
+
+        try {
+            auto result = options.parse(static_cast<int>(argv.size()), argv.data());
+            if (!result.count("instance") || !result.count("output")) {
+                throw std::runtime_error("expected <instance> <output> [options]");
+            }
+            job.instance = result["instance"].as<std::string>();
+            job.output = result["output"].as<std::string>();
+            job.settings = mpp::cli::make_solve_settings(result);
+            job.presolve = result["presolve"].as<bool>();
+            if (result.count("previous")) job.previous = result["previous"].as<std::string>();
+        } catch (const std::exception& e) {
+            job.error = e.what();
+        }
+
+        return job;
+    }
+
+
+    /**
+     * @brief Load (and restrict to the changes from the previous instance and presolve, if enabled) the instance of a job.
+     */
+    loaded_instance_t load_instance(const job_t& job) {
+        loaded_instance_t loaded;
+        if (!job.error.empty()) return loaded;
+
+        cxxtimer::Timer timer(true);
+        try {
+            loaded.problem = std::make_shared<mpp::problem_t>(job.instance);
+            if (!job.previous.empty()) {
+                mpp::restrict_to_affected(*loaded.problem, mpp::problem_t(job.previous), job.settings.initial_solutions.front());
+            }
+            if (job.presolve) mpp::presolve(*loaded.problem);
+        } catch (const std::exception& e) {
+            loaded.error = e.what();
+        }
+        loaded.load_time = timer.count<cxxtimer::ms>() / 1000.0;
+        return loaded;
+    }
+
+
+    /**
+     * @brief Quote a CSV field, if needed.
+     */
+    std::string csv(const std::string& field) {
+        if (field.find_first_of(",\"\n") == std::string::npos) return field;
+        std::string quoted = "\"";
+        for (char c : field) {
+            if (c == '"') quoted += '"';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+} // namespace
+
+
+int mpp::cli::batch(int argc, char** argv) {
+
+    // Parse command line arguments using cxxopts
+    cxxopts::Options options("mpp batch", "Solve a batch of maintenance planning problem instances.");
+    options.add_options()
+        ("manifest", "Path to the manifest file (one \"<instance> <output> [solver options]\" job per line).", cxxopts::value<std::string>())
+        ("cores", "Total number of cores shared by all jobs.", cxxopts::value<int>()->default_value(std::to_string(std::max(1u, std::thread::hardware_concurrency()))))
+        ("summary", "Path to the summary CSV file.", cxxopts::value<std::string>()->default_value("summary.csv"))
+        ("stats", "Path to a JSON file with counters and a per-phase time breakdown of all jobs.", cxxopts::value<std::string>())
+        ("trace", "Path to a JSON file with a timeline of the phases of each thread (Chrome Trace Event format).", cxxopts::value<std::string>())
+        ("v,verbose", "Report the start and the end of each job.", cxxopts::value<bool>()->default_value("false"))
+        ("h,help", "Show help message.");
+
+        options.parse_positional({"manifest"});
+        options.positional_help("<MANIFEST>");
+
+    try {
+
+        // Parse the command line arguments and show help if needed
+        auto result = options.parse(argc, argv);
+        if (result.count("help")) {
+            std::cout << options.help() << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        const int cores = std::max(1, result["cores"].as<int>());
+        const bool verbose = result["verbose"].as<bool>();
+        mpp::stats::reset();
+        if (result.count("trace")) mpp::trace::start();
+
+        // Read the jobs from the manifest
+        const std::string manifest_file = result["manifest"].as<std::string>();
+        std::ifstream manifest_in(manifest_file);
+        if (!manifest_in.is_open()) {
+            throw std::runtime_error("Error opening manifest file " + manifest_file + " for reading.");
+        }
+
+        std::vector<job_t> jobs;
+        std::string line;
+        while (std::getline(manifest_in, line)) {
+            auto tokens = tokenize(line);
+            if (tokens.empty() || tokens[0][0] == '#') continue;
+            jobs.push_back(parse_job(tokens));
+        }
+
+        // Single pool of workers shared by all jobs, and the number of cores not yet reserved by a job
+        mpp::thread_pool_t thread_pool(cores);
+        int available_cores = cores;
+        std::mutex mtx;
+        std::condition_variable cv;
+
+        std::vector<job_result_t> results(jobs.size());
+        std::vector< std::future<void> > running;
+
+        // SIGINT/SIGTERM stop all jobs (running and pending) early, still writing their best solutions
+        mpp::cancellation_token_t interrupted;
+        interrupted.cancel_on_signals();
+
+        // The instance of the next job is loaded while the current ones are solving
+        std::future<loaded_instance_t> next_instance;
+        if (!jobs.empty()) {
+            next_instance = std::async(std::launch::async, load_instance, std::cref(jobs[0]));
+        }
+
+        for (size_t k = 0; k < jobs.size(); ++k) {
+            loaded_instance_t loaded = next_instance.get();
+            if (k + 1 < jobs.size()) {
+                next_instance = std::async(std::launch::async, load_instance, std::cref(jobs[k + 1]));
+            }
+
+            job_t& job = jobs[k];
+            job_result_t& job_result = results[k];
+            job_result.load_time = loaded.load_time;
+            if (!job.error.empty() || !loaded.error.empty()) {
+                job_result.status = "error";
+                job_result.error = (!job.error.empty() ? job.error : loaded.error);
+                std::lock_guard<std::mutex> lock(mtx);
+                std::cerr << "Job " << k + 1 << " failed: " << job_result.error << std::endl;
+                continue;
+            }
+
+            // Wait until the cores requested by the job (for all its solver threads) are available
+            const int threads = mpp::cli::fit_solve_threads(job.settings, cores);
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&]() { return available_cores >= threads; });
+                available_cores -= threads;
+                if (verbose) std::cout << "Job " << k + 1 << " started: " << job.instance << " (" << threads << " threads)" << std::endl;
+            }
+
+            job.settings.thread_pool = &thread_pool;
+            job.settings.cancellation = interrupted;
+
+            running.push_back(thread_pool.submit([&, k, threads, problem = loaded.problem]() {
+                job_t& job = jobs[k];
+                job_result_t& job_result = results[k];
+                cxxtimer::Timer timer(true);
+
+                try {
+                    auto [solution, objective, risk_metrics, constraints] = mpp::solver::differential_evolution(*problem, job.settings);
+                    mpp::save_solution(solution, job.output);
+
+                    job_result.status = "ok";
+                    job_result.objective = objective;
+                    std::tie(job_result.mean_risk, job_result.expected_excess) = risk_metrics;
+                    std::tie(job_result.exclusions, job_result.resource_count, job_result.resource_sum) = constraints;
+                } catch (const std::exception& e) {
+                    job_result.status = "error";
+                    job_result.error = e.what();
+                }
+                job_result.solve_time = timer.count<cxxtimer::ms>() / 1000.0;
+
+                // Release the cores of the job
+                std::lock_guard<std::mutex> lock(mtx);
+                available_cores += threads;
+                if (verbose) {
+                    std::cout << "Job " << k + 1 << " finished: " << job_result.status
+                              << " (" << std::fixed << std::setprecision(2) << job_result.solve_time << " s)" << std::endl;
+                }
+                cv.notify_all();
+            }));
+        }
+
+        for (auto& job_running : running) {
+            job_running.get();
+        }
+
+        // Write the summary
+        const std::string summary_file = result["summary"].as<std::string>();
+        std::ofstream summary_out(summary_file);
+        if (!summary_out.is_open()) {
+            throw std::runtime_error("Error opening summary file " + summary_file + " for writing.");
+        }
+
+        bool all_ok = true;
+        summary_out << "job,instance,output,status,threads,objective,mean_risk,expected_excess,"
+                    << "exclusions,resource_count,resource_sum,load_time,solve_time,error" << std::endl;
+        summary_out << std::setprecision(12);
+        for (size_t k = 0; k < jobs.size(); ++k) {
+            const auto& job = jobs[k];
+            const auto& job_result = results[k];
+            all_ok &= (job_result.status == "ok");
+            summary_out << k + 1 << "," << csv(job.instance) << "," << csv(job.output) << "," << job_result.status << ","
+                        << job.settings.threads << "," << job_result.objective << "," << job_result.mean_risk << ","
+                        << job_result.expected_excess << "," << job_result.exclusions << "," << job_result.resource_count << ","
+                        << job_result.resource_sum << "," << job_result.load_time << "," << job_result.solve_time << ","
+                        << csv(job_result.error) << std::endl;
+        }
+
+        // Export the counters, times and timeline of all jobs
+        if (result.count("stats")) {
+            mpp::stats::save_report(result["stats"].as<std::string>());
+        }
+        if (result.count("trace")) {
+            mpp::trace::stop();
+            mpp::trace::save(result["trace"].as<std::string>());
+        }
+
+        return all_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    } catch (const cxxopts::exceptions::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::cerr << options.help() << std::endl;
+        return EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    } catch (...) {
+        std::cerr << "Unknown error occurred." << std::endl;
+        return EXIT_FAILURE;
+    }
+}
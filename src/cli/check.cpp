@@ -0,0 +1,289 @@
+#include <cli/cli.hpp>
+#include <problem.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cxxopts.hpp>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+
+namespace {
+
+    /**
+     * @brief Metrics reported by a checker.
+     */
+    struct check_report_t {
+        double mean_risk = 0.0;
+        double expected_excess = 0.0;
+        double objective = 0.0;
+        bool evaluated = false;
+        int errors = 0;
+    };
+
+
+    /**
+     * @brief Run the Python checker of the challenge and parse its output.
+     */
+    check_report_t run_python_checker(const std::string& python_exe, const std::string& checker,
+                                      const std::string& instance_file, const std::string& solution_file) {
+
+        const std::string command = python_exe + " \"" + checker + "\" \"" + instance_file + "\" \"" + solution_file + "\"";
+        std::unique_ptr<FILE, decltype(&pclose)> pipe(popen(command.c_str(), "r"), &pclose);
+        if (!pipe) {
+            throw std::runtime_error("Failed to run the Python checker: " + command);
+        }
+
+        // Read the whole output
+        std::string output;
+        char buffer[4096];
+        while (fgets(buffer, sizeof(buffer), pipe.get()) != nullptr) {
+            output += buffer;
+        }
+
+        // Parse the relevant lines
+        check_report_t report;
+        int objectives_found = 0;
+        std::istringstream output_in(output);
+        std::string line;
+        while (std::getline(output_in, line)) {
+            const size_t value_pos = line.rfind(':');
+            if (line.rfind("ERROR:", 0) == 0) {
+                ++report.errors;
+            } else if (line.find("Objective 1 (mean risk):") != std::string::npos) {
+                report.mean_risk = std::stod(line.substr(value_pos + 1));
+                ++objectives_found;
+            } else if (line.find("Objective 2 (expected excess") != std::string::npos) {
+                report.expected_excess = std::stod(line.substr(value_pos + 1));
+                ++objectives_found;
+            } else if (line.find("Total objective") != std::string::npos) {
+                report.objective = std::stod(line.substr(value_pos + 1));
+                ++objectives_found;
+            }
+        }
+
+        if (objectives_found != 3) {
+            throw std::runtime_error("Unexpected output from the Python checker:\n" + output);
+        }
+
+        report.evaluated = true;
+        return report;
+    }
+
+} // namespace
+
+
+int mpp::cli::check(int argc, char** argv) {
+
+    // Parse command line arguments using cxxopts
+    cxxopts::Options options("mpp check", "Check a solution of the maintenance planning problem.");
+    options.add_options()
+        ("instance", "Path to the instance file.", cxxopts::value<std::string>())
+        ("solution", "Path to the solution file.", cxxopts::value<std::string>())
+        ("python", "Path to the Python checker. If given, its results are compared with the ones computed here (regression mode).", cxxopts::value<std::string>())
+        ("python_exe", "Python interpreter used to run the Python checker.", cxxopts::value<std::string>()->default_value("python3"))
+        ("tolerance", "Relative tolerance used to compare the objectives in regression mode.", cxxopts::value<double>()->default_value("1e-6"))
+        ("h,help", "Show help message.");
+
+        options.parse_positional({"instance", "solution"});
+        options.positional_help("<INSTANCE> <SOLUTION_FILE>");
+
+    try {
+
+        // Parse the command line arguments and show help if needed
+        auto result = options.parse(argc, argv);
+        if (result.count("help")) {
+            std::cout << options.help() << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        // Load instance data and the solution
+        const std::string instance_file = result["instance"].as<std::string>();
+        const std::string solution_file = result["solution"].as<std::string>();
+        mpp::problem_t problem(instance_file);
+
+        std::vector<std::string> messages;
+        mpp::solution_t solution = mpp::load_solution(solution_file, &messages);
+
+        const auto& data = problem.get_data();
+        const auto& intervention_names = problem.get_intervention_names();
+        const auto& resource_names = problem.get_resource_names();
+        const int T = problem.get_T();
+        constexpr double tolerance = 1e-5;
+
+        check_report_t report;
+        int schedule_violations = 0;
+        int upper_bound_violations = 0;
+        int lower_bound_violations = 0;
+        int exclusion_violations = 0;
+
+        auto error = [&](const std::string& message) {
+            std::cout << "ERROR: " << message << std::endl;
+            ++report.errors;
+        };
+
+        for (const auto& message : messages) {
+            error(message);
+        }
+
+        // Interventions that do not exist in the instance
+        std::map<std::string, size_t> index;
+        for (size_t i = 0; i < intervention_names.size(); ++i) {
+            index[intervention_names[i]] = i;
+        }
+        for (auto it = solution.begin(); it != solution.end(); ) {
+            if (index.find(it->first) == index.end()) {
+                error("Unexpected Intervention " + it->first + " in solution file " + solution_file + ".");
+                it = solution.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        // Schedule constraints (4.1)
+        for (size_t i = 0; i < intervention_names.size(); ++i) {
+            const auto& intervention_name = intervention_names[i];
+            auto it = solution.find(intervention_name);
+            if (it == solution.end()) {
+                error("Schedule constraint 4.1.2: Intervention " + intervention_name + " has not been scheduled.");
+                ++schedule_violations;
+            } else if (it->second < 1 || it->second > T) {
+                error("Schedule constraint 4.1 time validity: Intervention " + intervention_name + " starting time " + std::to_string(it->second)
+                      + " is not a valid starting date. Expected value between 1 and " + std::to_string(T) + ".");
+                ++schedule_violations;
+            } else if (it->second > problem.get_tmax(i)) {
+                error("Schedule constraint 4.1.3: Intervention " + intervention_name + " realization exceeds time limit."
+                      + " It starts at " + std::to_string(it->second) + " while time limit is " + std::to_string(problem.get_tmax(i)) + ".");
+                ++schedule_violations;
+            }
+        }
+
+        if (schedule_violations == 0) {
+
+            std::vector<int> start_time(intervention_names.size());
+            for (size_t i = 0; i < intervention_names.size(); ++i) {
+                start_time[i] = solution.at(intervention_names[i]);
+            }
+
+            // Resources constraints (4.2)
+            std::vector< std::vector<double> > usage(resource_names.size(), std::vector<double>(T, 0.0));
+            for (size_t i = 0; i < intervention_names.size(); ++i) {
+                for (const auto& w : problem.get_workload(i, start_time[i])) {
+                    usage[w.resource][w.period] += w.amount;
+                }
+            }
+
+            for (size_t r = 0; r < resource_names.size(); ++r) {
+                const auto& upper_bound = problem.get_resource_upper_bound(r);
+                const auto& lower_bound = problem.get_resource_lower_bound(r);
+                for (int t = 0; t < T; ++t) {
+                    std::ostringstream values;
+                    values << std::setprecision(16) << "Value " << usage[r][t];
+                    if (usage[r][t] > upper_bound[t] + tolerance) {
+                        values << " is greater than bound " << upper_bound[t] << " plus tolerance " << tolerance << ".";
+                        error("Resources constraint 4.2 upper bound: Worload on Resource " + resource_names[r] + " at time " + std::to_string(t + 1)
+                              + " exceeds upper bound. " + values.str());
+                        ++upper_bound_violations;
+                    }
+                    if (usage[r][t] < lower_bound[t] - tolerance) {
+                        values << " is lower than bound " << lower_bound[t] << " minus tolerance " << tolerance << ".";
+                        error("Resources constraint 4.2 lower bound: Worload on Resource " + resource_names[r] + " at time " + std::to_string(t + 1)
+                              + " does not match lower bound. " + values.str());
+                        ++lower_bound_violations;
+                    }
+                }
+            }
+
+            // Exclusions constraints (4.3)
+            for (const auto& exclusion : problem.get_exclusions()) {
+                const int s1 = start_time[exclusion.intervention_1];
+                const int s2 = start_time[exclusion.intervention_2];
+                const int e1 = s1 + problem.get_delta(exclusion.intervention_1, s1);
+                const int e2 = s2 + problem.get_delta(exclusion.intervention_2, s2);
+                for (int t : exclusion.season) {
+                    if (s1 <= t && t < e1 && s2 <= t && t < e2) {
+                        error("Exclusions constraint 4.3: Interventions " + intervention_names[exclusion.intervention_1] + " and "
+                              + intervention_names[exclusion.intervention_2] + " are both ongoing at time " + std::to_string(t) + ".");
+                        ++exclusion_violations;
+                    }
+                }
+            }
+
+            // Objectives (using the evaluator of the solver)
+            auto [objective, risk_metric, constraints] = problem.evaluate(solution);
+            std::tie(report.mean_risk, report.expected_excess) = risk_metric;
+            report.objective = objective;
+            report.evaluated = true;
+        }
+
+        // Print the report
+        std::cout << std::setprecision(16);
+        std::cout << "Instance infos:" << std::endl;
+        std::cout << "\tInterventions number: " << intervention_names.size() << std::endl;
+        std::cout << "\tScenario numbers: " << data[mpp::params::SCENARIOS_NUMBER].size() << std::endl;
+        std::cout << "Constraint violations:" << std::endl;
+        std::cout << "\tSchedule: " << schedule_violations << std::endl;
+        std::cout << "\tResources (upper bound): " << upper_bound_violations << std::endl;
+        std::cout << "\tResources (lower bound): " << lower_bound_violations << std::endl;
+        std::cout << "\tExclusions: " << exclusion_violations << std::endl;
+        std::cout << "Solution evaluation:" << std::endl;
+        if (report.evaluated) {
+            std::cout << "\tObjective 1 (mean risk): " << report.mean_risk << std::endl;
+            std::cout << "\tObjective 2 (expected excess  (Q" << data[mpp::params::QUANTILE].template get<double>() << ")): " << report.expected_excess << std::endl;
+            std::cout << "\tTotal objective (alpha*mean_risk + (1-alpha)*expected_excess): " << report.objective << std::endl;
+        } else {
+            std::cout << "\tNot evaluated: the schedule is incomplete or invalid." << std::endl;
+        }
+
+        bool ok = (report.errors == 0);
+
+        // Compare with the Python checker (regression mode)
+        if (result.count("python")) {
+            const double rel_tolerance = result["tolerance"].as<double>();
+            check_report_t reference = run_python_checker(result["python_exe"].as<std::string>(), result["python"].as<std::string>(),
+                                                          instance_file, solution_file);
+
+            auto compare = [&](const std::string& name, double value, double reference_value) {
+                bool match = std::fabs(value - reference_value) <= rel_tolerance * std::max(1.0, std::fabs(reference_value));
+                std::cout << "\t" << name << ": " << (match ? "OK" : "MISMATCH")
+                          << " (" << value << " vs " << reference_value << ")" << std::endl;
+                return match;
+            };
+
+            std::cout << "Regression (Python checker):" << std::endl;
+            bool match = true;
+            if (report.evaluated) {
+                match &= compare("Objective 1 (mean risk)", report.mean_risk, reference.mean_risk);
+                match &= compare("Objective 2 (expected excess)", report.expected_excess, reference.expected_excess);
+                match &= compare("Total objective", report.objective, reference.objective);
+            }
+            match &= compare("Errors", report.errors, reference.errors);
+            std::cout << "\t" << (match ? "PASSED" : "FAILED") << std::endl;
+            ok = match;
+        }
+
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    } catch (const cxxopts::exceptions::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::cerr << options.help() << std::endl;
+        return EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    } catch (...) {
+        std::cerr << "Unknown error occurred." << std::endl;
+        return EXIT_FAILURE;
+    }
+}
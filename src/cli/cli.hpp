@@ -0,0 +1,106 @@
+#ifndef INCLUDE_MPP_CLI_CLI_HPP_
+#define INCLUDE_MPP_CLI_CLI_HPP_
+
+#include <cxxopts.hpp>
+#include <solver/differential_evolution.hpp>
+
+
+namespace mpp {
+    namespace cli {
+
+        /**
+         * @brief Add the options of the solver (DE settings, presolve, verbosity) to a parser.
+         * @details Shared by the solve command and the jobs of the batch mode.
+         * @param options The command line parser.
+         */
+        void add_solve_options(cxxopts::Options& options);
+
+        /**
+         * @brief Build the DE settings from parsed solver options (see add_solve_options).
+         * @param result The parsed options.
+         * @return The DE settings.
+         */
+        solver::differential_evolution_settings_t make_solve_settings(const cxxopts::ParseResult& result);
+
+        /**
+         * @brief Fit all the threads of a solve into a number of cores.
+         * @details A solve runs the DE threads (also used by the Relaxed MIP) and, in the Gurobi build with the
+         * LNS enabled, the LNS workers with the Gurobi threads of their sub-MIPs (while the DE waits for them).
+         * The thread counts of the settings are reduced so that no phase uses more than the given cores.
+         * @param settings The DE settings (updated).
+         * @param cores Number of cores available to the solve.
+         * @return The number of cores used at most by the solve, to reserve from a shared budget.
+         */
+        int fit_solve_threads(solver::differential_evolution_settings_t& settings, int cores);
+
+        /**
+         * @brief Entry point of the "mpp check <instance> <solution>" subcommand.
+         * @details Checks a solution file against an instance and reports the same metrics as the
+         * Python checker of the challenge (mean risk, expected excess, total objective and each
+         * constraint violation). With --python, the Python checker is also run on the same files and
+         * its results are compared with the ones computed here (regression mode).
+         * @param argc Number of arguments (the first one is the subcommand name).
+         * @param argv Arguments.
+         * @return EXIT_SUCCESS if the solution is feasible (in regression mode, if both checkers agree),
+         * EXIT_FAILURE otherwise.
+         */
+        int check(int argc, char** argv);
+
+        /**
+         * @brief Entry point of the "mpp batch <manifest>" subcommand.
+         * @details Solves a list of jobs read from a manifest file, one job per line in the form
+         * "<instance> <output> [solver options]" (empty lines and lines starting with '#' are ignored).
+         * Jobs are scheduled over a single thread pool with a total core budget: a job starts only when
+         * the threads it requests are available. The instance of the next job is loaded while the
+         * current ones are solving. A summary CSV with the objective, violations and times of each
+         * job is written at the end.
+         * @param argc Number of arguments (the first one is the subcommand name).
+         * @param argv Arguments.
+         * @return EXIT_SUCCESS if all jobs were solved, EXIT_FAILURE otherwise.
+         */
+        int batch(int argc, char** argv);
+
+        /**
+         * @brief Entry point of the "mpp tune <instances>" subcommand.
+         * @details Tunes pool_size, best1_ratio, scaling_factor and crossover_rho with a racing procedure
+         * (F-race): sampled configurations (and the base one, from the solver options) are run on one block
+         * (instance and seed) after the other, with the runs of a block in parallel on a shared thread pool.
+         * After a few blocks, a Friedman test and its post-hoc comparison eliminate the configurations that
+         * are statistically worse than the best one. Configurations and results are appended to a state
+         * file, so an interrupted race is resumed from it.
+         * @param argc Number of arguments (the first one is the subcommand name).
+         * @param argv Arguments.
+         * @return EXIT_SUCCESS if the race finished, EXIT_FAILURE otherwise.
+         */
+        int tune(int argc, char** argv);
+
+        /**
+         * @brief Entry point of the "mpp serve <socket>" subcommand.
+         * @details Listens on a Unix-domain socket for requests, one JSON object per line. Instances are
+         * loaded and compiled once ("load") and kept resident, so repeated "solve" and "evaluate" requests
+         * only pay for their overrides (decreased tmax, fixed interventions, resource bounds) and the presolve.
+         * Solves share a budget of cores: each one waits until the cores of all its solver threads are free,
+         * and runs in its connection thread and a thread pool shared by all requests. Each improvement of the
+         * incumbent is streamed to the client before the final result. Each request gets one or more response
+         * lines, the last one with "event" set to "result" or "error".
+         * @param argc Number of arguments (the first one is the subcommand name).
+         * @param argv Arguments.
+         * @return EXIT_SUCCESS after a "shutdown" request, EXIT_FAILURE on errors.
+         */
+        int serve(int argc, char** argv);
+
+        /**
+         * @brief Entry point of the "mpp client <socket>" subcommand.
+         * @details Sends the requests read from the standard input (one JSON object per line) to a server
+         * started with "mpp serve" and prints its responses.
+         * @param argc Number of arguments (the first one is the subcommand name).
+         * @param argv Arguments.
+         * @return EXIT_SUCCESS if no request failed, EXIT_FAILURE otherwise.
+         */
+        int client(int argc, char** argv);
+
+    } // namespace cli
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_CLI_CLI_HPP_
@@ -0,0 +1,124 @@
+#include <cli/cli.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+void mpp::cli::add_solve_options(cxxopts::Options& options) {
+    options.add_options()
+        ("pool_size", "Number of solutions in the pool.", cxxopts::value<int>()->default_value("36"))
+        ("best1_ratio", "Probability of choosing DE/best/1 mutation strategy instead of DE/rand/1.", cxxopts::value<double>()->default_value("0.37"))
+        ("scaling_factor", "Scaling factor for mutation.", cxxopts::value<double>()->default_value("0.16"))
+        ("crossover_rho", "Rho parameter for crossover recombination.", cxxopts::value<double>()->default_value("0.30"))
+        ("initial", "Solution file used to seed the pool and the MIP starts (can be given more than once).", cxxopts::value< std::vector<std::string> >())
+        ("initial_mutation", "Probability of changing each start time in the mutated copies of the initial solutions.", cxxopts::value<double>()->default_value("0.05"))
+        ("previous", "Previous version of the instance (requires --initial): only the interventions affected by the changes are re-optimized.", cxxopts::value<std::string>())
+        ("presolve", "Remove provably infeasible start times before solving.", cxxopts::value<bool>()->default_value("true"))
+        ("timelimit", "Limits the runtime in seconds. Use -1 for no limit.", cxxopts::value<long long int>()->default_value("900"))
+        ("max_generations", "Limits the number of generations. Use -1 for no limit.", cxxopts::value<long long int>()->default_value("-1"))
+        ("gap", "Stops when the relative gap between the best (feasible) solution and the lower bound is at most this value. Use -1 to disable it.", cxxopts::value<double>()->default_value("0"))
+        ("mip_timelimit", "Limits the runtime of the MIP solver in seconds. Use -1 for no limit.", cxxopts::value<long long int>()->default_value("-1"))
+        ("mip_starts", "Number of solutions from the pool used as MIP starts. Use 0 for a cold start.", cxxopts::value<size_t>()->default_value("4"))
+        ("threads", "Number of threads for parallel processing.", cxxopts::value<int>()->default_value("2"))
+        ("repair", "Repair the trial vectors of the DE (move the interventions involved in violations to better start times) before evaluating them.", cxxopts::value<bool>()->default_value("false"))
+        ("repair_budget", "Maximum number of start times evaluated by the repair of a trial vector.", cxxopts::value<long long int>()->default_value("1000"))
+        ("lagrangian_iterations", "Number of subgradient iterations of the Lagrangian relaxation (lower bound and repaired solutions) run after the seed solution. Use 0 to disable it.", cxxopts::value<long long int>()->default_value("0"))
+        ("risk_precision", "Precision of the scenario risks used to rank the DE pool: float64, float32 or int16 (quantized with a scale per row). The best solutions are re-scored in double precision.", cxxopts::value<std::string>()->default_value("float64"))
+        ("lns_stall", "Number of generations without improvement before running the LNS. Use 0 to disable it.", cxxopts::value<long long int>()->default_value("100"))
+        ("lns_timelimit", "Limits the runtime of each LNS run in seconds.", cxxopts::value<double>()->default_value("30"))
+        ("lns_subproblem_timelimit", "Limits the runtime of each LNS sub-MIP in seconds.", cxxopts::value<double>()->default_value("5"))
+        ("lns_neighborhood_size", "Number of interventions freed in each LNS sub-MIP.", cxxopts::value<size_t>()->default_value("20"))
+        ("lns_workers", "Number of LNS sub-MIPs solved concurrently.", cxxopts::value<int>()->default_value("2"))
+        ("checkpoint", "Path to a checkpoint file with the state of the run, written periodically (in the background) and at the end of the run.", cxxopts::value<std::string>())
+        ("checkpoint_interval", "Time between checkpoints in seconds.", cxxopts::value<double>()->default_value("60"))
+        ("resume", "Resume the run from a checkpoint file (written with --checkpoint for the same instance and pool size).", cxxopts::value<std::string>())
+        ("convergence", "Path to a CSV file logging each improvement of the best solution (time, evaluations, source engine, fitness and its components).", cxxopts::value<std::string>())
+        ("seed", "Random seed for generating a random solution.", cxxopts::value<unsigned int>()->default_value("0"))
+        ("v,verbose", "Enable verbose output.", cxxopts::value<bool>()->default_value("false"));
+}
+
+
+mpp::solver::differential_evolution_settings_t
+mpp::cli::make_solve_settings(const cxxopts::ParseResult& result) {
+    mpp::solver::differential_evolution_settings_t settings;
+    settings.pool_size = result["pool_size"].as<int>();
+    settings.best1_ratio = result["best1_ratio"].as<double>();
+    settings.scaling_factor = result["scaling_factor"].as<double>();
+    settings.crossover_rho = result["crossover_rho"].as<double>();
+    settings.initial_mutation = result["initial_mutation"].as<double>();
+    settings.timelimit = result["timelimit"].as<long long int>();
+    settings.max_generations = result["max_generations"].as<long long int>();
+    settings.gap = result["gap"].as<double>();
+    settings.mip_timelimit = result["mip_timelimit"].as<long long int>();
+    settings.mip_starts = result["mip_starts"].as<size_t>();
+    settings.threads = result["threads"].as<int>();
+    settings.repair = result["repair"].as<bool>();
+    settings.repair_budget = result["repair_budget"].as<long long int>();
+    settings.lagrangian_iterations = result["lagrangian_iterations"].as<long long int>();
+    settings.risk_precision = mpp::parse_risk_precision(result["risk_precision"].as<std::string>());
+    settings.lns_stall = result["lns_stall"].as<long long int>();
+    settings.lns.timelimit = result["lns_timelimit"].as<double>();
+    settings.lns.subproblem_timelimit = result["lns_subproblem_timelimit"].as<double>();
+    settings.lns.neighborhood_size = result["lns_neighborhood_size"].as<size_t>();
+    settings.lns.workers = result["lns_workers"].as<int>();
+    settings.checkpoint = result.count("checkpoint") ? result["checkpoint"].as<std::string>() : "";
+    settings.checkpoint_interval = result["checkpoint_interval"].as<double>();
+    settings.resume = result.count("resume") ? result["resume"].as<std::string>() : "";
+    settings.seed = result["seed"].as<unsigned int>();
+    settings.verbose = result["verbose"].as<bool>();
+
+    // Load the initial solutions
+    if (result.count("initial")) {
+        for (const auto& initial_file : result["initial"].as< std::vector<std::string> >()) {
+            settings.initial_solutions.push_back(mpp::load_solution(initial_file));
+        }
+    }
+    if (result.count("previous") && settings.initial_solutions.empty()) {
+        throw std::invalid_argument("Option --previous requires an initial solution (--initial).");
+    }
+
+    // Log each improvement of the best solution (the file is kept open by the callback)
+    if (result.count("convergence")) {
+        const std::string convergence_file = result["convergence"].as<std::string>();
+        auto out = std::make_shared<std::ofstream>(convergence_file);
+        if (!out->is_open()) {
+            throw std::runtime_error("Error opening convergence file " + convergence_file + " for writing.");
+        }
+        *out << "time,evaluations,source,violations,exclusions,resource_count,resource_sum,mean_risk,expected_excess,objective" << std::endl;
+        *out << std::setprecision(12);
+        settings.on_incumbent = [out](const std::vector<int>&, const mpp::solver::fitness_t& fitness, const mpp::solver::incumbent_event_t& event) {
+            const auto& [violations, resource_sum, objective] = fitness;
+            *out << event.time << "," << event.evaluations << "," << event.source << ","
+                 << violations << "," << event.exclusions << "," << event.resource_count << "," << resource_sum << ","
+                 << event.mean_risk << "," << event.expected_excess << "," << objective << std::endl;
+        };
+    }
+
+    // Set timelimit properly
+    if (settings.timelimit < 0) settings.timelimit = std::numeric_limits<long long int>::max();
+
+    return settings;
+}
+
+
+int mpp::cli::fit_solve_threads(mpp::solver::differential_evolution_settings_t& settings, int cores) {
+    cores = std::max(1, cores);
+    settings.threads = std::min(cores, std::max(1, settings.threads));
+    int solve_threads = settings.threads;
+
+#ifdef MPP_WITH_GUROBI
+    // Each LNS worker solves its sub-MIPs with its own Gurobi threads
+    if (settings.lns_stall > 0) {
+        settings.lns.threads = std::min(cores, std::max(1, settings.lns.threads));
+        settings.lns.workers = std::min(std::max(1, settings.lns.workers), cores / settings.lns.threads);
+        solve_threads = std::max(solve_threads, settings.lns.workers * settings.lns.threads);
+    }
+#endif
+
+    return solve_threads;
+}
@@ -0,0 +1,629 @@
+#include <cli/cli.hpp>
+#include <cancellation.hpp>
+#include <deadline.hpp>
+#include <problem.hpp>
+#include <presolve.hpp>
+#include <thread_pool.hpp>
+#include <solver/incumbent.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cxxopts.hpp>
+#include <cxxtimer.hpp>
+
+#ifndef _WIN32
+#include <csignal>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+
+#ifndef _WIN32
+namespace {
+
+    using mpp::json;
+
+
+    /**
+     * @brief Newline-delimited messages over a connected socket.
+     * @details Reads are done by a single thread; writes are serialized, so they can be done from any thread.
+     */
+    class line_socket_t {
+        public:
+        explicit line_socket_t(int fd) : fd_(fd) { }
+
+        bool read_line(std::string& line) {
+            while (true) {
+                const size_t pos = buffer_.find('\n');
+                if (pos != std::string::npos) {
+                    line = buffer_.substr(0, pos);
+                    buffer_.erase(0, pos + 1);
+                    return true;
+                }
+
+                char chunk[4096];
+                const ssize_t count = ::read(fd_, chunk, sizeof(chunk));
+                if (count < 0 && errno == EINTR) continue;
+                if (count <= 0) {
+                    if (buffer_.empty()) return false;
+                    line.swap(buffer_);
+                    buffer_.clear();
+                    return true;
+                }
+                buffer_.append(chunk, static_cast<size_t>(count));
+            }
+        }
+
+        bool write_line(const std::string& line) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            const std::string message = line + "\n";
+            size_t written = 0;
+            while (written < message.size()) {
+                const ssize_t count = ::write(fd_, message.data() + written, message.size() - written);
+                if (count < 0 && errno == EINTR) continue;
+                if (count <= 0) return false;
+                written += static_cast<size_t>(count);
+            }
+            return true;
+        }
+
+        private:
+        int fd_;
+        std::string buffer_;
+        std::mutex mtx_;
+    };
+
+
+    /**
+     * @brief Address of a Unix-domain socket.
+     */
+    sockaddr_un make_address(const std::string& path) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error("Socket path " + path + " is too long.");
+        }
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        return address;
+    }
+
+
+    /**
+     * @brief State shared by the connections of the server.
+     */
+    struct server_t {
+        explicit server_t(int cores) : cores(cores), thread_pool(cores), available_cores(cores) { }
+
+        int cores;
+        mpp::thread_pool_t thread_pool;
+        bool verbose = false;
+        mpp::cancellation_token_t stopping;     // Cancelled by a shutdown request or by SIGINT/SIGTERM
+
+        std::mutex mtx;
+        std::map< std::string, std::shared_ptr<const mpp::problem_t> > instances;
+
+        // Cores not reserved by a running solve (guarded by mtx)
+        int available_cores;
+        std::condition_variable cores_released;
+
+        // Cancellation tokens of the running solves (guarded by mtx), cancelled when the server stops
+        std::map<size_t, mpp::cancellation_token_t> solves;
+        size_t next_solve = 0;
+
+        // Sockets of the open connections (guarded by mtx)
+        std::set<int> connections;
+        std::condition_variable connections_closed;
+    };
+
+
+    /**
+     * @brief Get a resident instance by name.
+     */
+    std::shared_ptr<const mpp::problem_t> find_instance(server_t& server, const json& request) {
+        const std::string name = request.at("instance").get<std::string>();
+        std::lock_guard<std::mutex> lock(server.mtx);
+        auto it = server.instances.find(name);
+        if (it == server.instances.end()) {
+            throw std::invalid_argument("Instance " + name + " is not loaded.");
+        }
+        return it->second;
+    }
+
+
+    /**
+     * @brief Copy of a resident instance with the overrides of a request applied (and presolved, if enabled).
+     * @details Overrides: {"tmax": {<intervention>: <tmax>}, "fixed": {<intervention>: <start time>},
+     * "resources": {<resource>: {"min": [...], "max": [...]}}}. A tmax can only be decreased, and a fixed start time
+     * must be allowed by the (decreased) tmax of its intervention.
+     */
+    mpp::problem_t make_problem(const mpp::problem_t& instance, const json& request) {
+        mpp::problem_t problem(instance);
+        const json overrides = request.value("overrides", json::object());
+        const json tmax_overrides = overrides.value("tmax", json::object());
+        const json fixed_overrides = overrides.value("fixed", json::object());
+        const json resource_overrides = overrides.value("resources", json::object());
+
+        const auto& intervention_names = problem.get_intervention_names();
+        auto intervention_index = [&](const std::string& name) {
+            auto it = std::find(intervention_names.begin(), intervention_names.end(), name);
+            if (it == intervention_names.end()) throw std::invalid_argument("Unknown intervention " + name + ".");
+            return static_cast<size_t>(it - intervention_names.begin());
+        };
+
+        // Decreased start time limits
+        for (const auto& [name, value] : tmax_overrides.items()) {
+            const size_t i = intervention_index(name);
+            const int tmax = value.get<int>();
+            std::vector<int> allowed_starts;
+            for (int s : problem.get_allowed_starts(i)) {
+                if (s <= tmax) allowed_starts.push_back(s);
+            }
+            problem.restrict_allowed_starts(i, allowed_starts);
+        }
+
+        // Fixed interventions
+        for (const auto& [name, value] : fixed_overrides.items()) {
+            const size_t i = intervention_index(name);
+            const int start_time = value.get<int>();
+            const auto& allowed_starts = problem.get_allowed_starts(i);
+            if (!std::binary_search(allowed_starts.begin(), allowed_starts.end(), start_time)) {
+                throw std::invalid_argument("Invalid start time " + std::to_string(start_time) + " for Intervention " + name
+                                            + " (not allowed by its tmax and the other overrides).");
+            }
+            problem.restrict_allowed_starts(i, { start_time });
+        }
+
+        // Resource bounds
+        const auto& resource_names = problem.get_resource_names();
+        for (const auto& [name, bounds] : resource_overrides.items()) {
+            auto it = std::find(resource_names.begin(), resource_names.end(), name);
+            if (it == resource_names.end()) throw std::invalid_argument("Unknown resource " + name + ".");
+            const size_t r = static_cast<size_t>(it - resource_names.begin());
+            problem.set_resource_bounds(r,
+                bounds.value("min", problem.get_resource_lower_bound(r)),
+                bounds.value("max", problem.get_resource_upper_bound(r)));
+        }
+
+        if (request.value("presolve", true)) {
+            mpp::presolve(problem);
+        }
+
+        return problem;
+    }
+
+
+    /**
+     * @brief Evaluation of a solution as a response object.
+     */
+    json make_evaluation(const std::tuple<mpp::objective_t, mpp::risk_metric_t, mpp::constraints_t>& evaluation) {
+        const auto& [objective, risk_metric, constraints] = evaluation;
+        const auto& [mean_risk, expected_excess] = risk_metric;
+        const auto& [exclusions, resource_count, resource_sum] = constraints;
+        return {
+            {"objective", objective}, {"mean_risk", mean_risk}, {"expected_excess", expected_excess},
+            {"exclusions", exclusions}, {"resource_count", resource_count}, {"resource_sum", resource_sum}
+        };
+    }
+
+
+    json handle_load(server_t& server, const json& request) {
+        const std::string path = request.at("path").get<std::string>();
+        const std::string name = request.value("name", path);
+
+        cxxtimer::Timer timer(true);
+        auto problem = std::make_shared<const mpp::problem_t>(path);
+        const double load_time = timer.count<cxxtimer::ms>() / 1000.0;
+
+        {
+            std::lock_guard<std::mutex> lock(server.mtx);
+            server.instances[name] = problem;
+        }
+
+        return {
+            {"event", "result"}, {"name", name}, {"interventions", problem->get_intervention_names().size()},
+            {"resources", problem->get_resource_names().size()}, {"T", problem->get_T()}, {"load_time", load_time}
+        };
+    }
+
+
+    json handle_unload(server_t& server, const json& request) {
+        const std::string name = request.at("instance").get<std::string>();
+        std::lock_guard<std::mutex> lock(server.mtx);
+        if (server.instances.erase(name) == 0) {
+            throw std::invalid_argument("Instance " + name + " is not loaded.");
+        }
+        return { {"event", "result"}, {"name", name} };
+    }
+
+
+    json handle_list(server_t& server, const json&) {
+        json names = json::array();
+        std::lock_guard<std::mutex> lock(server.mtx);
+        for (const auto& [name, problem] : server.instances) {
+            names.push_back(name);
+        }
+        return { {"event", "result"}, {"instances", names} };
+    }
+
+
+    json handle_evaluate(server_t& server, const json& request) {
+        mpp::problem_t problem = make_problem(*find_instance(server, request), request);
+        const mpp::solution_t solution = request.at("solution").get<mpp::solution_t>();
+
+        // The evaluation requires a start time in [1, tmax] for each intervention
+        const auto& intervention_names = problem.get_intervention_names();
+        for (size_t i = 0; i < intervention_names.size(); ++i) {
+            auto it = solution.find(intervention_names[i]);
+            if (it == solution.end()) {
+                throw std::invalid_argument("Intervention " + intervention_names[i] + " has not been scheduled.");
+            }
+            if (it->second < 1 || it->second > problem.get_tmax(i)) {
+                throw std::invalid_argument("Invalid start time " + std::to_string(it->second) + " for Intervention " + intervention_names[i] + ".");
+            }
+        }
+
+        json response = make_evaluation(problem.evaluate(solution));
+        response["event"] = "result";
+        return response;
+    }
+
+
+    /**
+     * @brief Registration of a running solve, so that it is cancelled when the server stops.
+     */
+    class solve_registration_t {
+        public:
+        solve_registration_t(server_t& server, const mpp::cancellation_token_t& cancellation) : server_(server) {
+            std::lock_guard<std::mutex> lock(server_.mtx);
+            if (server_.stopping.cancelled()) {
+                throw std::runtime_error("The server is shutting down.");
+            }
+            id_ = server_.next_solve++;
+            server_.solves.emplace(id_, cancellation);
+        }
+
+        ~solve_registration_t() {
+            std::lock_guard<std::mutex> lock(server_.mtx);
+            server_.solves.erase(id_);
+        }
+
+        private:
+        server_t& server_;
+        size_t id_ = 0;
+    };
+
+
+    /**
+     * @brief Reservation of the cores of a solve, released when the solve ends.
+     * @details Waits until the cores are available. The solve runs in the thread of its connection, which
+     * counts as one of its cores, and the other ones are used through the shared thread pool.
+     */
+    class core_reservation_t {
+        public:
+        core_reservation_t(server_t& server, int cores, const mpp::deadline_t& deadline, const mpp::cancellation_token_t& cancellation)
+            : server_(server), cores_(cores) {
+            std::unique_lock<std::mutex> lock(server_.mtx);
+            while (server_.available_cores < cores_) {
+                if (server_.stopping.cancelled() || cancellation.cancelled()) {
+                    throw std::runtime_error("The server is shutting down.");
+                }
+                if (deadline.expired()) {
+                    throw std::runtime_error("No cores became available within the time limit.");
+                }
+                server_.cores_released.wait_for(lock, std::chrono::milliseconds(200));
+            }
+            server_.available_cores -= cores_;
+        }
+
+        ~core_reservation_t() {
+            std::lock_guard<std::mutex> lock(server_.mtx);
+            server_.available_cores += cores_;
+            server_.cores_released.notify_all();
+        }
+
+        private:
+        server_t& server_;
+        int cores_;
+    };
+
+
+    json handle_solve(server_t& server, const json& request, line_socket_t& socket) {
+
+        // The time limit counts from the request (including the presolve of the instance), and the solve is
+        // cancelled when the server stops or the client cannot be written to
+        const long long int timelimit = request.value("timelimit", 60LL);
+        const mpp::deadline_t deadline(static_cast<double>(timelimit));
+        mpp::cancellation_token_t cancellation;
+        solve_registration_t registration(server, cancellation);
+        const auto instance = find_instance(server, request);
+
+        // Settings (the defaults of the DE, except for the verbosity)
+        mpp::solver::differential_evolution_settings_t settings;
+        settings.verbose = false;
+        settings.timelimit = timelimit;
+        settings.deadline = deadline;
+        settings.cancellation = cancellation;
+        settings.threads = request.value("threads", 1);
+        settings.seed = request.value("seed", settings.seed);
+        settings.pool_size = request.value("pool_size", settings.pool_size);
+        settings.best1_ratio = request.value("best1_ratio", settings.best1_ratio);
+        settings.scaling_factor = request.value("scaling_factor", settings.scaling_factor);
+        settings.crossover_rho = request.value("crossover_rho", settings.crossover_rho);
+        settings.max_generations = request.value("max_generations", settings.max_generations);
+        settings.gap = request.value("gap", settings.gap);
+        settings.mip_timelimit = request.value("mip_timelimit", settings.mip_timelimit);
+        settings.mip_starts = request.value("mip_starts", settings.mip_starts);
+        settings.repair = request.value("repair", settings.repair);
+        settings.repair_budget = request.value("repair_budget", settings.repair_budget);
+        settings.lagrangian_iterations = request.value("lagrangian_iterations", settings.lagrangian_iterations);
+        settings.risk_precision = mpp::parse_risk_precision(request.value("risk_precision", std::string("float64")));
+        settings.lns_stall = request.value("lns_stall", settings.lns_stall);
+        settings.thread_pool = &server.thread_pool;
+        if (settings.timelimit < 0) {
+            settings.timelimit = std::numeric_limits<long long int>::max();
+        }
+
+        // Wait until the cores of the solve (for all its solver threads) are available
+        core_reservation_t reservation(server, mpp::cli::fit_solve_threads(settings, server.cores), deadline, cancellation);
+
+        mpp::problem_t problem = make_problem(*instance, request);
+        const auto& intervention_names = problem.get_intervention_names();
+
+        // Stream each improvement of the incumbent
+        const bool stream_solutions = request.value("solutions", false);
+        settings.on_incumbent = [&](const std::vector<int>& start_time, const mpp::solver::fitness_t& fitness, const mpp::solver::incumbent_event_t& incumbent_event) {
+            const auto& [violations, resource_sum, objective] = fitness;
+            json event = { {"event", "incumbent"}, {"time", incumbent_event.time}, {"evaluations", incumbent_event.evaluations},
+                           {"lower_bound", incumbent_event.lower_bound}, {"source", incumbent_event.source}, {"violations", violations},
+                           {"resource_sum", resource_sum}, {"objective", objective} };
+            if (stream_solutions) {
+                json solution = json::object();
+                for (size_t i = 0; i < intervention_names.size(); ++i) {
+                    solution[intervention_names[i]] = start_time[i];
+                }
+                event["solution"] = solution;
+            }
+            if (!socket.write_line(event.dump())) cancellation.cancel();
+        };
+
+        cxxtimer::Timer timer(true);
+        auto [solution, objective, risk_metric, constraints] = mpp::solver::differential_evolution(problem, settings);
+
+        if (request.contains("output")) {
+            mpp::save_solution(solution, request["output"].get<std::string>());
+        }
+
+        json response = make_evaluation(std::make_tuple(objective, risk_metric, constraints));
+        response["event"] = "result";
+        response["time"] = timer.count<cxxtimer::ms>() / 1000.0;
+        response["solution"] = solution;
+        return response;
+    }
+
+
+    /**
+     * @brief Serve the requests of a client until it disconnects.
+     */
+    void serve_connection(server_t& server, int fd) {
+        line_socket_t socket(fd);
+        std::string line;
+        while (socket.read_line(line)) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+            json response;
+            try {
+                const json request = json::parse(line);
+                const std::string command = request.at("command").get<std::string>();
+                if (server.verbose) std::cout << "Request: " << command << std::endl;
+
+                if (command == "load") {
+                    response = handle_load(server, request);
+                } else if (command == "unload") {
+                    response = handle_unload(server, request);
+                } else if (command == "list") {
+                    response = handle_list(server, request);
+                } else if (command == "evaluate") {
+                    response = handle_evaluate(server, request);
+                } else if (command == "solve") {
+                    response = handle_solve(server, request, socket);
+                } else if (command == "shutdown") {
+                    server.stopping.cancel();
+                    response = { {"event", "result"} };
+                } else {
+                    throw std::invalid_argument("Unknown command " + command + ".");
+                }
+            } catch (const std::exception& e) {
+                response = { {"event", "error"}, {"message", e.what()} };
+            }
+
+            if (!socket.write_line(response.dump())) break;
+        }
+
+        std::lock_guard<std::mutex> lock(server.mtx);
+        server.connections.erase(fd);
+        ::close(fd);
+        server.connections_closed.notify_all();
+    }
+
+} // namespace
+#endif
+
+
+int mpp::cli::serve(int argc, char** argv) {
+
+    // Parse command line arguments using cxxopts
+    cxxopts::Options options("mpp serve", "Keep maintenance planning problem instances resident and solve them on request.");
+    options.add_options()
+        ("socket", "Path to the Unix-domain socket.", cxxopts::value<std::string>()->default_value("mpp.sock"))
+        ("cores", "Total number of cores shared by all requests.", cxxopts::value<int>()->default_value(std::to_string(std::max(1u, std::thread::hardware_concurrency()))))
+        ("v,verbose", "Report each request.", cxxopts::value<bool>()->default_value("false"))
+        ("h,help", "Show help message.");
+
+        options.parse_positional({"socket"});
+        options.positional_help("<SOCKET>");
+
+    try {
+
+        // Parse the command line arguments and show help if needed
+        auto result = options.parse(argc, argv);
+        if (result.count("help")) {
+            std::cout << options.help() << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+#ifdef _WIN32
+        throw std::runtime_error("mpp serve requires Unix-domain sockets, which are not supported on this platform.");
+#else
+        const std::string socket_path = result["socket"].as<std::string>();
+        server_t server(std::max(1, result["cores"].as<int>()));
+        server.verbose = result["verbose"].as<bool>();
+
+        // Clients may disconnect while a response is being written
+        std::signal(SIGPIPE, SIG_IGN);
+
+        // Listen on the socket
+        const sockaddr_un address = make_address(socket_path);
+        const int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd < 0) {
+            throw std::runtime_error("Error creating socket: " + std::string(std::strerror(errno)));
+        }
+        ::unlink(socket_path.c_str());
+        if (::bind(listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0 || ::listen(listen_fd, 16) < 0) {
+            const std::string error = std::strerror(errno);
+            ::close(listen_fd);
+            throw std::runtime_error("Error listening on socket " + socket_path + ": " + error);
+        }
+        if (server.verbose) std::cout << "Listening on " << socket_path << std::endl;
+
+        // Accept connections (each one is served by its own thread) until a shutdown request or a signal
+        server.stopping.cancel_on_signals();
+        while (!server.stopping.cancelled()) {
+            pollfd listen_poll = { listen_fd, POLLIN, 0 };
+            if (::poll(&listen_poll, 1, 200) <= 0) continue;
+
+            const int fd = ::accept(listen_fd, nullptr, nullptr);
+            if (fd < 0) continue;
+
+            std::lock_guard<std::mutex> lock(server.mtx);
+            server.connections.insert(fd);
+            std::thread(serve_connection, std::ref(server), fd).detach();
+        }
+
+        // Stop the idle connections, cancel the running solves (they answer with their best solution)
+        // and wait for them
+        ::close(listen_fd);
+        ::unlink(socket_path.c_str());
+        std::unique_lock<std::mutex> lock(server.mtx);
+        for (int fd : server.connections) {
+            ::shutdown(fd, SHUT_RD);
+        }
+        for (const auto& [id, cancellation] : server.solves) {
+            cancellation.cancel();
+        }
+        server.connections_closed.wait(lock, [&]() { return server.connections.empty(); });
+
+        return EXIT_SUCCESS;
+#endif
+
+    } catch (const cxxopts::exceptions::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::cerr << options.help() << std::endl;
+        return EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    } catch (...) {
+        std::cerr << "Unknown error occurred." << std::endl;
+        return EXIT_FAILURE;
+    }
+}
+
+
+int mpp::cli::client(int argc, char** argv) {
+
+    // Parse command line arguments using cxxopts
+    cxxopts::Options options("mpp client", "Send requests (one JSON object per line, read from the standard input) to a server started with mpp serve.");
+    options.add_options()
+        ("socket", "Path to the Unix-domain socket.", cxxopts::value<std::string>()->default_value("mpp.sock"))
+        ("h,help", "Show help message.");
+
+        options.parse_positional({"socket"});
+        options.positional_help("<SOCKET>");
+
+    try {
+
+        // Parse the command line arguments and show help if needed
+        auto result = options.parse(argc, argv);
+        if (result.count("help")) {
+            std::cout << options.help() << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+#ifdef _WIN32
+        throw std::runtime_error("mpp client requires Unix-domain sockets, which are not supported on this platform.");
+#else
+        const std::string socket_path = result["socket"].as<std::string>();
+
+        // Connect to the server
+        const sockaddr_un address = make_address(socket_path);
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+            throw std::runtime_error("Error connecting to socket " + socket_path + ": " + std::strerror(errno));
+        }
+        line_socket_t socket(fd);
+
+        // Send each request and print its responses (the incumbents of a solve request are
+        // streamed before its result)
+        bool ok = true;
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+            if (!socket.write_line(line)) {
+                throw std::runtime_error("Connection closed by the server.");
+            }
+
+            std::string response;
+            while (true) {
+                if (!socket.read_line(response)) {
+                    throw std::runtime_error("Connection closed by the server.");
+                }
+                std::cout << response << std::endl;
+                const std::string event = json::parse(response).value("event", "");
+                if (event == "error") ok = false;
+                if (event != "incumbent") break;
+            }
+        }
+
+        ::close(fd);
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+#endif
+
+    } catch (const cxxopts::exceptions::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::cerr << options.help() << std::endl;
+        return EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    } catch (...) {
+        std::cerr << "Unknown error occurred." << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,407 @@
+#include <cli/cli.hpp>
+#include <problem.hpp>
+#include <presolve.hpp>
+#include <thread_pool.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cxxopts.hpp>
+
+
+namespace {
+
+    using mpp::json;
+    using mpp::solver::fitness_t;
+
+
+    /**
+     * @brief A candidate configuration of the DE.
+     */
+    struct configuration_t {
+        size_t pool_size = 36;
+        double best1_ratio = 0.37;
+        double scaling_factor = 0.16;
+        double crossover_rho = 0.30;
+    };
+
+
+    /**
+     * @brief Quantile of the standard normal distribution (Acklam's rational approximation).
+     */
+    double normal_quantile(double p) {
+        static const double a[] = { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                    1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00 };
+        static const double b[] = { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                    6.680131188771972e+01, -1.328068155288572e+01 };
+        static const double c[] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                    -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+        static const double d[] = { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                    3.754408661907416e+00 };
+
+        if (p < 0.02425) {
+            const double q = std::sqrt(-2.0 * std::log(p));
+            return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                   ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+        }
+        if (p > 1.0 - 0.02425) {
+            return -normal_quantile(1.0 - p);
+        }
+        const double q = p - 0.5;
+        const double r = q * q;
+        return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+               (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    }
+
+
+    /**
+     * @brief Quantile of the chi-squared distribution (Wilson-Hilferty approximation).
+     */
+    double chi_squared_quantile(double p, double df) {
+        const double z = normal_quantile(p);
+        const double h = 2.0 / (9.0 * df);
+        return df * std::pow(1.0 - h + z * std::sqrt(h), 3.0);
+    }
+
+
+    /**
+     * @brief Quantile of the Student's t distribution (Cornish-Fisher expansion).
+     */
+    double t_quantile(double p, double df) {
+        const double z = normal_quantile(p);
+        const double z3 = z * z * z;
+        const double z5 = z3 * z * z;
+        const double z7 = z5 * z * z;
+        return z + (z3 + z) / (4.0 * df) + (5.0 * z5 + 16.0 * z3 + 3.0 * z) / (96.0 * df * df)
+                 + (3.0 * z7 + 19.0 * z5 + 17.0 * z3 - 15.0 * z) / (384.0 * df * df * df);
+    }
+
+
+    /**
+     * @brief Ranks of the fitness values (1 is the best, ties get the average rank).
+     */
+    std::vector<double> rank(const std::vector<fitness_t>& values) {
+        std::vector<size_t> order(values.size());
+        for (size_t k = 0; k < order.size(); ++k) order[k] = k;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return values[a] < values[b]; });
+
+        std::vector<double> ranks(values.size());
+        for (size_t first = 0; first < order.size(); ) {
+            size_t last = first;
+            while (last + 1 < order.size() && values[order[last + 1]] == values[order[first]]) ++last;
+            for (size_t k = first; k <= last; ++k) ranks[order[k]] = (first + last) / 2.0 + 1.0;
+            first = last + 1;
+        }
+        return ranks;
+    }
+
+
+    /**
+     * @brief Friedman test over the blocks, followed by the post-hoc comparison with the best configuration
+     * (as in F-race).
+     * @param results Fitness of each configuration (columns) in each block (rows).
+     * @param alpha Significance level.
+     * @return For each configuration, whether it is statistically worse than the best one.
+     */
+    std::vector<bool> friedman_race(const std::vector< std::vector<fitness_t> >& results, double alpha) {
+        const size_t n = results.size();
+        const size_t k = results.front().size();
+        std::vector<bool> worse(k, false);
+        if (n < 2 || k < 2) return worse;
+
+        std::vector<double> rank_sum(k, 0.0);
+        double sum_squared_ranks = 0.0;
+        for (const auto& block : results) {
+            auto ranks = rank(block);
+            for (size_t j = 0; j < k; ++j) {
+                rank_sum[j] += ranks[j];
+                sum_squared_ranks += ranks[j] * ranks[j];
+            }
+        }
+
+        const double C = n * k * (k + 1.0) * (k + 1.0) / 4.0;
+        if (sum_squared_ranks - C <= 1e-12) return worse;  // All configurations tied in all blocks
+
+        double statistic = 0.0;
+        double sum_squared_rank_sums = 0.0;
+        for (size_t j = 0; j < k; ++j) {
+            statistic += std::pow(rank_sum[j] - n * (k + 1.0) / 2.0, 2.0);
+            sum_squared_rank_sums += rank_sum[j] * rank_sum[j];
+        }
+        statistic *= (k - 1.0) / (sum_squared_ranks - C);
+        if (statistic <= chi_squared_quantile(1.0 - alpha, k - 1.0)) return worse;
+
+        // Post-hoc: configurations whose rank sum is too far from the best one
+        const double df = (n - 1.0) * (k - 1.0);
+        const double threshold = t_quantile(1.0 - alpha / 2.0, df) * std::sqrt(2.0 * (n * sum_squared_ranks - sum_squared_rank_sums) / df);
+        const double best = *std::min_element(rank_sum.begin(), rank_sum.end());
+        for (size_t j = 0; j < k; ++j) {
+            worse[j] = (rank_sum[j] - best > threshold);
+        }
+        return worse;
+    }
+
+
+    /**
+     * @brief Key of the result of a configuration in a block.
+     */
+    std::string result_key(size_t configuration, size_t block) {
+        return std::to_string(configuration) + ":" + std::to_string(block);
+    }
+
+} // namespace
+
+
+int mpp::cli::tune(int argc, char** argv) {
+
+    // Parse command line arguments using cxxopts
+    cxxopts::Options options("mpp tune", "Tune the DE settings (pool_size, best1_ratio, scaling_factor, crossover_rho) with a race over instances and seeds.\n"
+                                         "The other solver options apply to all runs (the base configuration is also raced).");
+    options.add_options()
+        ("instances", "Paths to the instance files.", cxxopts::value< std::vector<std::string> >())
+        ("seeds", "Number of seeds (runs of each configuration on each instance).", cxxopts::value<size_t>()->default_value("10"))
+        ("configurations", "Number of configurations (including the base one).", cxxopts::value<size_t>()->default_value("32"))
+        ("pool_size_range", "Range of the pool size.", cxxopts::value< std::vector<size_t> >()->default_value("10,100"))
+        ("best1_ratio_range", "Range of the probability of the DE/best/1 mutation.", cxxopts::value< std::vector<double> >()->default_value("0,1"))
+        ("scaling_factor_range", "Range of the scaling factor.", cxxopts::value< std::vector<double> >()->default_value("0.05,1"))
+        ("crossover_rho_range", "Range of the rho parameter of the crossover.", cxxopts::value< std::vector<double> >()->default_value("0.05,0.95"))
+        ("first_test", "Number of blocks (instance and seed) before the first elimination test.", cxxopts::value<size_t>()->default_value("5"))
+        ("alpha", "Significance level of the tests.", cxxopts::value<double>()->default_value("0.05"))
+        ("max_runs", "Limits the number of runs. Use 0 for no limit.", cxxopts::value<size_t>()->default_value("0"))
+        ("cores", "Total number of cores shared by the runs.", cxxopts::value<int>()->default_value(std::to_string(std::max(1u, std::thread::hardware_concurrency()))))
+        ("state", "Path to the state file (the race is resumed from it if it exists).", cxxopts::value<std::string>()->default_value("tune.jsonl"))
+        ("tune_seed", "Random seed for sampling the configurations.", cxxopts::value<unsigned int>()->default_value("0"))
+        ("h,help", "Show help message.");
+
+        mpp::cli::add_solve_options(options);
+
+        options.parse_positional({"instances"});
+        options.positional_help("<INSTANCE>...");
+
+    try {
+
+        // Parse the command line arguments and show help if needed
+        auto result = options.parse(argc, argv);
+        if (result.count("help") || !result.count("instances")) {
+            std::cout << options.help() << std::endl;
+            return result.count("help") ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        // Settings shared by all runs (short, single-threaded runs unless asked otherwise)
+        mpp::solver::differential_evolution_settings_t base_settings = mpp::cli::make_solve_settings(result);
+        if (!result.count("timelimit")) base_settings.timelimit = 10;
+        if (!result.count("threads")) base_settings.threads = 1;
+        const bool verbose = base_settings.verbose;
+        base_settings.verbose = false;
+        base_settings.on_incumbent = nullptr;
+
+        const auto instance_files = result["instances"].as< std::vector<std::string> >();
+        const size_t n_seeds = std::max<size_t>(1, result["seeds"].as<size_t>());
+        const size_t n_blocks = n_seeds * instance_files.size();
+        const size_t first_test = std::max<size_t>(2, result["first_test"].as<size_t>());
+        const double alpha = result["alpha"].as<double>();
+        const size_t max_runs = result["max_runs"].as<size_t>();
+        const int cores = std::max(1, result["cores"].as<int>());
+        const std::string state_file = result["state"].as<std::string>();
+
+        // Configurations and results: resumed from the state file or sampled
+        std::vector<configuration_t> configurations;
+        std::map<std::string, fitness_t> results;
+
+        std::ifstream state_in(state_file);
+        if (state_in.is_open()) {
+            std::string line;
+            while (std::getline(state_in, line)) {
+                if (line.empty()) continue;
+                json record = json::parse(line);
+                const std::string type = record["type"];
+                if (type == "race") {
+                    if (record["instances"].get< std::vector<std::string> >() != instance_files || record["seeds"].get<size_t>() != n_seeds) {
+                        throw std::runtime_error("The state file " + state_file + " belongs to a race with other instances or seeds.");
+                    }
+                } else if (type == "configuration") {
+                    configuration_t configuration;
+                    configuration.pool_size = record["pool_size"];
+                    configuration.best1_ratio = record["best1_ratio"];
+                    configuration.scaling_factor = record["scaling_factor"];
+                    configuration.crossover_rho = record["crossover_rho"];
+                    configurations.push_back(configuration);
+                } else if (type == "result") {
+                    results[result_key(record["configuration"], record["block"])] =
+                        std::make_tuple(record["violations"].get<double>(), record["resource_sum"].get<double>(), record["objective"].get<double>());
+                }
+            }
+            state_in.close();
+            if (verbose) std::cout << "Resuming the race: " << configurations.size() << " configurations, " << results.size() << " runs done." << std::endl;
+        }
+
+        std::ofstream state_out(state_file, std::ios::app);
+        if (!state_out.is_open()) {
+            throw std::runtime_error("Error opening state file " + state_file + " for writing.");
+        }
+
+        if (configurations.empty()) {
+            const auto pool_size_range = result["pool_size_range"].as< std::vector<size_t> >();
+            const auto best1_ratio_range = result["best1_ratio_range"].as< std::vector<double> >();
+            const auto scaling_factor_range = result["scaling_factor_range"].as< std::vector<double> >();
+            const auto crossover_rho_range = result["crossover_rho_range"].as< std::vector<double> >();
+            for (const auto* range : { &best1_ratio_range, &scaling_factor_range, &crossover_rho_range }) {
+                if (range->size() != 2 || range->front() > range->back()) throw std::invalid_argument("Ranges must be given as <min>,<max>.");
+            }
+            if (pool_size_range.size() != 2 || pool_size_range.front() < 4 || pool_size_range.front() > pool_size_range.back()) {
+                throw std::invalid_argument("The range of the pool size must be given as <min>,<max> (with min >= 4).");
+            }
+
+            // The base configuration and random ones
+            std::mt19937 rng(result["tune_seed"].as<unsigned int>());
+            auto uniform = [&](const std::vector<double>& range) { return std::uniform_real_distribution<double>(range[0], range[1])(rng); };
+            configurations.push_back({ base_settings.pool_size, base_settings.best1_ratio, base_settings.scaling_factor, base_settings.crossover_rho });
+            while (configurations.size() < std::max<size_t>(2, result["configurations"].as<size_t>())) {
+                configuration_t configuration;
+                configuration.pool_size = std::uniform_int_distribution<size_t>(pool_size_range[0], pool_size_range[1])(rng);
+                configuration.best1_ratio = uniform(best1_ratio_range);
+                configuration.scaling_factor = uniform(scaling_factor_range);
+                configuration.crossover_rho = uniform(crossover_rho_range);
+                configurations.push_back(configuration);
+            }
+
+            state_out << json({ {"type", "race"}, {"instances", instance_files}, {"seeds", n_seeds} }).dump() << std::endl;
+            for (size_t c = 0; c < configurations.size(); ++c) {
+                const auto& configuration = configurations[c];
+                state_out << json({ {"type", "configuration"}, {"id", c}, {"pool_size", configuration.pool_size},
+                                    {"best1_ratio", configuration.best1_ratio}, {"scaling_factor", configuration.scaling_factor},
+                                    {"crossover_rho", configuration.crossover_rho} }).dump() << std::endl;
+            }
+        }
+
+        // Load (and presolve) the instances once
+        std::vector< std::unique_ptr<mpp::problem_t> > problems;
+        for (const auto& instance_file : instance_files) {
+            problems.push_back(std::make_unique<mpp::problem_t>(instance_file));
+            if (result["presolve"].as<bool>()) mpp::presolve(*problems.back());
+        }
+
+        // Race: the blocks (one seed on each instance) are run in order, and the configurations that are
+        // statistically worse than the best one are eliminated
+        const size_t n_configurations = configurations.size();
+        std::vector<bool> alive(n_configurations, true);
+        std::vector<size_t> eliminated_at(n_configurations, 0);
+        std::vector<double> rank_sum(n_configurations, 0.0);
+        size_t alive_count = n_configurations;
+        size_t runs = results.size();
+        size_t blocks_done = 0;
+
+        const int threads_per_run = std::min(cores, std::max(1, base_settings.threads));
+        mpp::thread_pool_t thread_pool(static_cast<size_t>(std::max(1, cores - 1)));
+        std::mutex mtx;
+
+        for (size_t block = 0; block < n_blocks && alive_count > 1; ++block) {
+            const size_t instance = block % instance_files.size();
+            const unsigned int seed = base_settings.seed + static_cast<unsigned int>(block / instance_files.size());
+
+            // Runs of this block that are not in the state file
+            std::vector<size_t> pending;
+            for (size_t c = 0; c < n_configurations; ++c) {
+                if (alive[c] && !results.count(result_key(c, block))) pending.push_back(c);
+            }
+            if (max_runs > 0 && runs + pending.size() > max_runs) break;
+
+            thread_pool.parallel_for(pending.size(), [&](size_t k) {
+                const size_t c = pending[k];
+                mpp::solver::differential_evolution_settings_t settings = base_settings;
+                settings.pool_size = configurations[c].pool_size;
+                settings.best1_ratio = configurations[c].best1_ratio;
+                settings.scaling_factor = configurations[c].scaling_factor;
+                settings.crossover_rho = configurations[c].crossover_rho;
+                settings.seed = seed;
+                settings.threads = threads_per_run;
+                settings.thread_pool = &thread_pool;
+
+                auto [solution, objective, risk_metrics, constraints] = mpp::solver::differential_evolution(*problems[instance], settings);
+                fitness_t fitness = mpp::solver::make_fitness(std::make_tuple(objective, risk_metrics, constraints));
+                const auto& [violations, resource_sum, fitness_objective] = fitness;
+
+                std::lock_guard<std::mutex> lock(mtx);
+                results[result_key(c, block)] = fitness;
+                state_out << json({ {"type", "result"}, {"configuration", c}, {"block", block}, {"violations", violations},
+                                    {"resource_sum", resource_sum}, {"objective", fitness_objective} }).dump() << std::endl;
+            }, static_cast<size_t>(std::max(1, cores / threads_per_run)));
+            runs += pending.size();
+            ++blocks_done;
+
+            // Results of the configurations still in the race
+            std::vector<size_t> racing;
+            for (size_t c = 0; c < n_configurations; ++c) {
+                if (alive[c]) racing.push_back(c);
+            }
+            std::vector< std::vector<fitness_t> > table(blocks_done, std::vector<fitness_t>(racing.size()));
+            for (size_t b = 0; b < blocks_done; ++b) {
+                for (size_t k = 0; k < racing.size(); ++k) table[b][k] = results.at(result_key(racing[k], b));
+            }
+            std::vector<double> block_ranks = rank(table.back());
+            for (size_t k = 0; k < racing.size(); ++k) rank_sum[racing[k]] += block_ranks[k];
+
+            // Eliminate the configurations statistically worse than the best one
+            if (blocks_done >= first_test) {
+                auto worse = friedman_race(table, alpha);
+                for (size_t k = 0; k < racing.size(); ++k) {
+                    if (worse[k]) {
+                        alive[racing[k]] = false;
+                        eliminated_at[racing[k]] = blocks_done;
+                        --alive_count;
+                    }
+                }
+            }
+
+            if (verbose) {
+                std::cout << "Block " << blocks_done << "/" << n_blocks << " (" << instance_files[instance] << ", seed " << seed
+                          << "): " << alive_count << " configurations left." << std::endl;
+            }
+        }
+
+        // Report the configurations still in the race (best mean rank first)
+        std::vector<size_t> order;
+        for (size_t c = 0; c < n_configurations; ++c) {
+            if (alive[c]) order.push_back(c);
+        }
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return rank_sum[a] < rank_sum[b]; });
+
+        std::cout << "Runs: " << runs << ", blocks: " << blocks_done << "/" << n_blocks
+                  << ", configurations left: " << alive_count << "/" << n_configurations << std::endl;
+        std::cout << "id,pool_size,best1_ratio,scaling_factor,crossover_rho,mean_rank" << std::endl;
+        for (size_t c : order) {
+            const auto& configuration = configurations[c];
+            std::cout << c << "," << configuration.pool_size << "," << configuration.best1_ratio << ","
+                      << configuration.scaling_factor << "," << configuration.crossover_rho << ","
+                      << (blocks_done > 0 ? rank_sum[c] / blocks_done : 0.0) << std::endl;
+        }
+        if (!order.empty()) {
+            const auto& best = configurations[order.front()];
+            std::cout << "Best: --pool_size " << best.pool_size << " --best1_ratio " << best.best1_ratio
+                      << " --scaling_factor " << best.scaling_factor << " --crossover_rho " << best.crossover_rho << std::endl;
+        }
+
+    } catch (const cxxopts::exceptions::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::cerr << options.help() << std::endl;
+        return EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    } catch (...) {
+        std::cerr << "Unknown error occurred." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,67 @@
+#ifndef INCLUDE_MPP_DEADLINE_HPP_
+#define INCLUDE_MPP_DEADLINE_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+
+namespace mpp {
+
+    /**
+     * @brief Wall-clock deadline of a run.
+     * @details Created once (e.g., at the start of the process) and passed to every phase, so all of
+     * them (loading, MIP, DE, output) share the same time budget. A default-constructed deadline never
+     * expires.
+     */
+    class deadline_t {
+        public:
+        using clock_t = std::chrono::steady_clock;
+
+        /**
+         * @brief A deadline that never expires.
+         */
+        deadline_t() : at_(clock_t::time_point::max()) { }
+
+        /**
+         * @brief A deadline a number of seconds from now.
+         * @param seconds Seconds until the deadline (negative or very large values mean no deadline).
+         */
+        explicit deadline_t(double seconds) : at_(clock_t::time_point::max()) {
+            if (seconds >= 0.0 && seconds < 1e9) {
+                at_ = clock_t::now() + std::chrono::duration_cast<clock_t::duration>(std::chrono::duration<double>(seconds));
+            }
+        }
+
+        /**
+         * @brief Check whether the deadline has passed.
+         */
+        bool expired() const {
+            return at_ != clock_t::time_point::max() && clock_t::now() >= at_;
+        }
+
+        /**
+         * @brief Seconds until the deadline (0 if it has passed, infinity if there is no deadline).
+         */
+        double remaining() const {
+            if (at_ == clock_t::time_point::max()) return std::numeric_limits<double>::infinity();
+            return std::max(0.0, std::chrono::duration<double>(at_ - clock_t::now()).count());
+        }
+
+        /**
+         * @brief The earliest of this deadline and another one.
+         */
+        deadline_t earliest(const deadline_t& other) const {
+            deadline_t deadline;
+            deadline.at_ = std::min(at_, other.at_);
+            return deadline;
+        }
+
+        private:
+        clock_t::time_point at_;
+    };
+
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_DEADLINE_HPP_
@@ -0,0 +1,169 @@
+#include <generator.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+void
+mpp::generate_instance(const mpp::generator_settings_t& settings, std::ostream& out) {
+
+    // Check the settings
+    const int T = settings.T;
+    const size_t n = settings.interventions;
+    const size_t n_resources = settings.resources;
+    const size_t n_seasons = settings.seasons;
+    if (T < 1 || n < 1) {
+        throw std::invalid_argument("The instance must have at least one period and one intervention.");
+    }
+    if (settings.delta_min < 1 || settings.delta_min > settings.delta_max || settings.delta_max > T || settings.delta_variation < 0) {
+        throw std::invalid_argument("The durations must satisfy 1 <= delta_min <= delta_max <= T (and delta_variation >= 0).");
+    }
+    if (settings.scenarios_min < 1 || settings.scenarios_min > settings.scenarios_max) {
+        throw std::invalid_argument("The number of scenarios must satisfy 1 <= scenarios_min <= scenarios_max.");
+    }
+    if (n_seasons < 1 || n_seasons > static_cast<size_t>(T)) {
+        throw std::invalid_argument("The number of seasons must be in [1, T].");
+    }
+
+    // Random number generator (the instance only depends on the settings)
+    std::mt19937_64 rng(settings.seed);
+    std::uniform_real_distribution<double> unif(0.0, 1.0);
+    auto uniform_int = [&](int a, int b) { return a + static_cast<int>(rng() % static_cast<unsigned long long int>(b - a + 1)); };
+
+    // Numbers are written with 6 significant digits to keep large instances small
+    char buffer[32];
+    auto number = [&](double value) -> const char* {
+        std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+        return buffer;
+    };
+
+    // Global parameters
+    std::vector<int> scenarios(T);
+    for (auto& s : scenarios) s = uniform_int(settings.scenarios_min, settings.scenarios_max);
+
+    out << "{\n";
+    out << "\"T\": " << T << ",\n";
+    out << "\"Quantile\": " << number(settings.quantile) << ",\n";
+    out << "\"Alpha\": " << number(settings.alpha) << ",\n";
+    out << "\"Scenarios_number\": [";
+    for (int t = 0; t < T; ++t) out << (t > 0 ? ", " : "") << scenarios[t];
+    out << "],\n";
+
+    // Seasons (consecutive blocks of periods)
+    out << "\"Seasons\": {";
+    for (size_t k = 0; k < n_seasons; ++k) {
+        const int begin = static_cast<int>(k * T / n_seasons) + 1;
+        const int end = static_cast<int>((k + 1) * T / n_seasons);
+        out << (k > 0 ? ", " : "") << "\"season" << k + 1 << "\": [";
+        for (int t = begin; t <= end; ++t) out << (t > begin ? ", " : "") << "\"" << t << "\"";
+        out << "]";
+    }
+    out << "},\n";
+
+    // Interventions (the average usage of each resource is accumulated to set its bounds)
+    std::vector< std::vector<double> > usage(n_resources, std::vector<double>(T, 0.0));
+
+    out << "\"Interventions\": {\n";
+    for (size_t i = 0; i < n; ++i) {
+
+        // Durations by start time
+        const int base_delta = uniform_int(settings.delta_min, settings.delta_max);
+        const int tmax = T - base_delta + 1;
+        std::vector<int> delta(tmax);
+        int max_delta = 1;
+        for (int s = 1; s <= tmax; ++s) {
+            const int variation = uniform_int(-settings.delta_variation, settings.delta_variation);
+            delta[s - 1] = std::clamp(base_delta + variation, 1, T - s + 1);
+            max_delta = std::max(max_delta, delta[s - 1]);
+        }
+
+        out << (i > 0 ? ",\n" : "") << "\"I" << i + 1 << "\": {\"tmax\": \"" << tmax << "\", \"Delta\": [";
+        for (int s = 1; s <= tmax; ++s) out << (s > 1 ? ", " : "") << delta[s - 1];
+        out << "],\n";
+
+        // Start times (s) of the intervention that are ongoing at period t
+        auto for_each_start = [&](int t, auto&& fn) {
+            for (int s = std::max(1, t - max_delta + 1); s <= std::min(t, tmax); ++s) {
+                if (t < s + delta[s - 1]) fn(s);
+            }
+        };
+
+        // Workload: {resource: {period: {start time: amount}}}
+        out << "\"workload\": {";
+        bool first_resource = true;
+        for (size_t r = 0; r < n_resources; ++r) {
+            if (unif(rng) >= settings.resource_density) continue;
+            const double base_workload = 0.5 + unif(rng);
+
+            out << (first_resource ? "" : ", ") << "\"c" << r + 1 << "\": {";
+            first_resource = false;
+            bool first_period = true;
+            for (int t = 1; t <= T; ++t) {
+                bool first_start = true;
+                for_each_start(t, [&](int s) {
+                    const double amount = base_workload * (0.8 + 0.4 * unif(rng));
+                    usage[r][t - 1] += amount / tmax;
+                    if (first_start) out << (first_period ? "" : ", ") << "\"" << t << "\": {";
+                    out << (first_start ? "" : ", ") << "\"" << s << "\": " << number(amount);
+                    first_start = false;
+                    first_period = false;
+                });
+                if (!first_start) out << "}";
+            }
+            out << "}";
+        }
+        out << "},\n";
+
+        // Risk: {period: {start time: [risk of each scenario]}}, with a seasonal pattern
+        const double base_risk = 1.0 + 9.0 * unif(rng);
+        out << "\"risk\": {";
+        bool first_period = true;
+        for (int t = 1; t <= T; ++t) {
+            const double seasonality = 1.0 + 0.5 * std::sin(6.283185307179586 * t / T);
+            bool first_start = true;
+            for_each_start(t, [&](int s) {
+                if (first_start) out << (first_period ? "" : ", ") << "\"" << t << "\": {";
+                out << (first_start ? "" : ", ") << "\"" << s << "\": [";
+                for (int k = 0; k < scenarios[t - 1]; ++k) {
+                    out << (k > 0 ? ", " : "") << number(base_risk * seasonality * (0.25 + 1.5 * unif(rng)));
+                }
+                out << "]";
+                first_start = false;
+                first_period = false;
+            });
+            if (!first_start) out << "}";
+        }
+        out << "}}";
+    }
+    out << "\n},\n";
+
+    // Exclusions between random pairs of interventions
+    out << "\"Exclusions\": {";
+    for (size_t k = 0; n > 1 && k < settings.exclusions; ++k) {
+        const size_t i1 = rng() % n;
+        size_t i2 = rng() % (n - 1);
+        if (i2 >= i1) ++i2;
+        out << (k > 0 ? ", " : "") << "\"E" << k + 1 << "\": [\"I" << i1 + 1 << "\", \"I" << i2 + 1 << "\", \"season" << rng() % n_seasons + 1 << "\"]";
+    }
+    out << "},\n";
+
+    // Resources, with bounds proportional to their average usage per period
+    out << "\"Resources\": {";
+    for (size_t r = 0; r < n_resources; ++r) {
+        double average_usage = 0.0;
+        for (int t = 0; t < T; ++t) average_usage += usage[r][t];
+        average_usage /= T;
+
+        out << (r > 0 ? ", " : "") << "\"c" << r + 1 << "\": {\"min\": [";
+        for (int t = 0; t < T; ++t) out << (t > 0 ? ", " : "") << number(settings.resource_lower * average_usage);
+        out << "], \"max\": [";
+        for (int t = 0; t < T; ++t) out << (t > 0 ? ", " : "") << number(settings.resource_tightness * average_usage);
+        out << "]}";
+    }
+    out << "}\n";
+    out << "}\n";
+}
@@ -0,0 +1,62 @@
+#ifndef INCLUDE_MPP_GENERATOR_HPP_
+#define INCLUDE_MPP_GENERATOR_HPP_
+
+#include <cstddef>
+#include <ostream>
+
+
+namespace mpp {
+
+    /**
+     * @brief Settings of the synthetic instance generator.
+     * @param T Number of time periods.
+     * @param interventions Number of interventions.
+     * @param delta_min Minimum duration of an intervention.
+     * @param delta_max Maximum duration of an intervention (durations are uniform in [delta_min, delta_max]).
+     * @param delta_variation Maximum change of the duration of an intervention between start times.
+     * @param scenarios_min Minimum number of risk scenarios of a period.
+     * @param scenarios_max Maximum number of risk scenarios of a period (uniform in [scenarios_min, scenarios_max]).
+     * @param resources Number of resources.
+     * @param resource_density Probability of an intervention having a workload on each resource.
+     * @param resource_tightness Upper bound of a resource as a multiple of its average usage per period.
+     * @param resource_lower Lower bound of a resource as a multiple of its average usage per period.
+     * @param seasons Number of seasons (the horizon is split into seasons of equal length).
+     * @param exclusions Number of exclusions (between random pairs of interventions, in a random season).
+     * @param quantile Quantile of the risk.
+     * @param alpha Weight of the mean risk in the objective.
+     * @param seed Random seed (the same settings always produce the same instance).
+     */
+    struct generator_settings_t {
+        int T = 100;
+        size_t interventions = 100;
+        int delta_min = 1;
+        int delta_max = 5;
+        int delta_variation = 1;
+        int scenarios_min = 10;
+        int scenarios_max = 30;
+        size_t resources = 3;
+        double resource_density = 0.5;
+        double resource_tightness = 1.5;
+        double resource_lower = 0.0;
+        size_t seasons = 3;
+        size_t exclusions = 20;
+        double quantile = 0.95;
+        double alpha = 0.5;
+        unsigned long long int seed = 0;
+    };
+
+
+    /**
+     * @brief Write a synthetic instance in the format of the challenge.
+     * @details The instance is written while it is generated (one intervention at a time), so the memory
+     * used does not depend on the size of the instance. The bounds of the resources are written last, as
+     * they depend on the workloads generated.
+     * @param settings The generator settings.
+     * @param out Output stream.
+     */
+    void generate_instance(const generator_settings_t& settings, std::ostream& out);
+
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_GENERATOR_HPP_
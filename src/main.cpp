@@ -5,28 +5,47 @@
 #include <string>
 #include <cxxopts.hpp>
 
+#include <cli/cli.hpp>
 #include <problem.hpp>
+#include <presolve.hpp>
+#include <reoptimize.hpp>
+#include <stats.hpp>
+#include <trace.hpp>
 #include <solver/differential_evolution.hpp>
 
 
 int main(int argc, char** argv) {
 
+    // Dispatch subcommands
+    if (argc > 1 && std::string(argv[1]) == "check") {
+        return mpp::cli::check(argc - 1, argv + 1);
+    }
+    if (argc > 1 && std::string(argv[1]) == "batch") {
+        return mpp::cli::batch(argc - 1, argv + 1);
+    }
+    if (argc > 1 && std::string(argv[1]) == "tune") {
+        return mpp::cli::tune(argc - 1, argv + 1);
+    }
+    if (argc > 1 && std::string(argv[1]) == "serve") {
+        return mpp::cli::serve(argc - 1, argv + 1);
+    }
+    if (argc > 1 && std::string(argv[1]) == "client") {
+        return mpp::cli::client(argc - 1, argv + 1);
+    }
+
     // Parse command line arguments using cxxopts
-    cxxopts::Options options("mpp", "Solve the maintenance planning problem.");
+    cxxopts::Options options("mpp", "Solve the maintenance planning problem.\n"
+                                    "Subcommands: mpp check <INSTANCE> <SOLUTION_FILE>, mpp batch <MANIFEST>, mpp tune <INSTANCE>...,\n"
+                                    "             mpp serve <SOCKET>, mpp client <SOCKET> (use --help for details).");
     options.add_options()
         ("instance", "Path to the instance file.", cxxopts::value<std::string>())
         ("output", "Path to the output solution file.", cxxopts::value<std::string>())
-        ("pool_size", "Number of solutions in the pool.", cxxopts::value<int>()->default_value("36"))
-        ("best1_ratio", "Probability of choosing DE/best/1 mutation strategy instead of DE/rand/1.", cxxopts::value<double>()->default_value("0.37"))
-        ("scaling_factor", "Scaling factor for mutation.", cxxopts::value<double>()->default_value("0.16"))
-        ("crossover_rho", "Rho parameter for crossover recombination.", cxxopts::value<double>()->default_value("0.30"))
-        ("timelimit", "Limits the runtime in seconds. Use -1 for no limit.", cxxopts::value<long long int>()->default_value("900"))
-        ("mip_timelimit", "Limits the runtime of the MIP solver in seconds. Use -1 for no limit.", cxxopts::value<long long int>()->default_value("-1"))
-        ("threads", "Number of threads for parallel processing.", cxxopts::value<int>()->default_value("2"))
-        ("seed", "Random seed for generating a random solution.", cxxopts::value<unsigned int>()->default_value("0"))
-        ("v,verbose", "Enable verbose output.", cxxopts::value<bool>()->default_value("false"))
+        ("stats", "Path to a JSON file with counters and a per-phase time breakdown of the run.", cxxopts::value<std::string>())
+        ("trace", "Path to a JSON file with a timeline of the phases of each thread (Chrome Trace Event format).", cxxopts::value<std::string>())
         ("h,help", "Show help message.");
 
+        mpp::cli::add_solve_options(options);
+
         options.parse_positional({"instance", "output"});
         options.positional_help("<INSTANCE> <OUTPUT_FILE>");
 
@@ -39,24 +58,36 @@ int main(int argc, char** argv) {
             return 0;
         }
 
+        // Load DE settings from command line arguments. The time limit is a deadline for the whole run
+        // (loading, presolve, MIP, DE and output), and SIGINT/SIGTERM stop the run gracefully
+        mpp::solver::differential_evolution_settings_t settings = mpp::cli::make_solve_settings(result);
+        settings.deadline = mpp::deadline_t(static_cast<double>(settings.timelimit));
+        settings.cancellation.cancel_on_signals();
+
         // Load instance data
+        mpp::stats::reset();
+        if (result.count("trace")) mpp::trace::start();
         std::string instance_file = result["instance"].as<std::string>();
         mpp::problem_t problem(instance_file);
 
-        // Load DE settings from command line arguments
-        mpp::solver::differential_evolution_settings_t settings;
-        settings.pool_size = result["pool_size"].as<int>();
-        settings.best1_ratio = result["best1_ratio"].as<double>();
-        settings.scaling_factor = result["scaling_factor"].as<double>();
-        settings.crossover_rho = result["crossover_rho"].as<double>();
-        settings.timelimit = result["timelimit"].as<long long int>();
-        settings.mip_timelimit = result["mip_timelimit"].as<long long int>();
-        settings.threads = result["threads"].as<int>();
-        settings.seed = result["seed"].as<unsigned int>();
-        settings.verbose = result["verbose"].as<bool>();
-
-        // Set timelimit properly
-        if (settings.timelimit < 0) settings.timelimit = std::numeric_limits<long long int>::max();
+        // Re-optimize only the interventions affected by the changes from the previous instance
+        if (result.count("previous")) {
+            mpp::problem_t previous(result["previous"].as<std::string>());
+            size_t fixed = mpp::restrict_to_affected(problem, previous, settings.initial_solutions.front());
+            if (settings.verbose) {
+                std::cout << "Re-optimization: " << fixed << " of " << problem.get_intervention_names().size()
+                          << " interventions fixed (not affected by the changes)." << std::endl;
+            }
+        }
+
+        // Shrink the start time domains of the interventions
+        if (result["presolve"].as<bool>()) {
+            auto stats = mpp::presolve(problem);
+            if (settings.verbose) {
+                std::cout << "Presolve: " << stats.starts_before - stats.starts_after << " of " << stats.starts_before
+                          << " start times removed (" << stats.rounds << " rounds)." << std::endl;
+            }
+        }
 
         // Solve the problem
         auto [solution, objective, risk_metrics, constraints] = mpp::solver::differential_evolution(problem, settings);
@@ -64,6 +95,9 @@ int main(int argc, char** argv) {
         auto [constr_exclusions_count, constr_resource_count, constr_resource_sum] = constraints;
 
         // Print the results, if verbose is enabled
+        if (settings.verbose && settings.cancellation.cancelled()) {
+            std::cout << "Interrupted: writing the best solution found." << std::endl;
+        }
         if (settings.verbose) {
             std::cout << "Objective Function: " << objective << std::endl;
             std::cout << "Mean Risk: " << risk_mean << std::endl;
@@ -75,15 +109,16 @@ int main(int argc, char** argv) {
 
         // Export solution to a file
         std::string solution_file = result["output"].as<std::string>();
-        std::ofstream solution_out(solution_file);
-        if (!solution_out.is_open()) {
-            std::cerr << "Error opening solution file for writing." << std::endl;
-            return EXIT_FAILURE;
+        mpp::save_solution(solution, solution_file);
+
+        // Export the counters, times and timeline of the run
+        if (result.count("stats")) {
+            mpp::stats::save_report(result["stats"].as<std::string>());
         }
-        for (const auto& [intervention_name, start_time] : solution) {
-            solution_out << intervention_name << " " << start_time << std::endl;
+        if (result.count("trace")) {
+            mpp::trace::stop();
+            mpp::trace::save(result["trace"].as<std::string>());
         }
-        solution_out.close();
 
     } catch (const cxxopts::exceptions::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -0,0 +1,33 @@
+#ifndef INCLUDE_MPP_MPP_HPP_
+#define INCLUDE_MPP_MPP_HPP_
+
+/**
+ * @file mpp.hpp
+ * @brief Public API of libmpp: the problem instance and its evaluator, the presolve, the re-optimization
+ * helpers and the solvers.
+ * @details Hosts link the mpp::mpp target (see the install/export configuration) and include this header.
+ * Solvers run in the calling process: pass a cancellation_token_t to stop them and an incumbent
+ * callback to follow their progress (see differential_evolution_settings_t).
+ */
+
+#include <cancellation.hpp>
+#include <problem.hpp>
+#include <risk_table.hpp>
+#include <presolve.hpp>
+#include <reoptimize.hpp>
+#include <thread_pool.hpp>
+#include <solver/incumbent.hpp>
+#include <solver/checkpoint.hpp>
+#include <solver/constructive.hpp>
+#include <solver/lower_bound.hpp>
+#include <solver/repair.hpp>
+#include <solver/lagrangian.hpp>
+#include <solver/differential_evolution.hpp>
+
+#ifdef MPP_WITH_GUROBI
+#include <solver/relaxed_mip.hpp>
+#include <solver/lns.hpp>
+#endif
+
+
+#endif // INCLUDE_MPP_MPP_HPP_
@@ -0,0 +1,106 @@
+#include <presolve.hpp>
+#include <stats.hpp>
+#include <trace.hpp>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+
+mpp::presolve_stats_t
+mpp::presolve(mpp::problem_t& problem) {
+
+    mpp::stats::scoped_timer_t timer(mpp::stats::phase_t::presolve);
+    mpp::trace::span_t span("presolve");
+
+    constexpr double tolerance = 1e-5;
+    const size_t n = problem.get_intervention_names().size();
+
+    presolve_stats_t stats;
+    for (size_t i = 0; i < n; ++i) {
+        stats.starts_before += problem.get_allowed_starts(i).size();
+    }
+
+    // Restrict the domain of an intervention to the start times that pass a test,
+    // unless no start time would be left
+    auto filter = [&](size_t i, auto&& keep) {
+        const auto& domain = problem.get_allowed_starts(i);
+        std::vector<int> filtered;
+        std::copy_if(domain.begin(), domain.end(), std::back_inserter(filtered), keep);
+        if (!filtered.empty() && filtered.size() < domain.size()) {
+            problem.restrict_allowed_starts(i, filtered);
+            return true;
+        }
+        return false;
+    };
+
+    // Rule (i): the workload of a single intervention exceeds the upper bound of a resource.
+    // It is valid only if workloads are non-negative (other interventions can only add usage).
+    bool non_negative = true;
+    for (size_t i = 0; i < n && non_negative; ++i) {
+        for (int s : problem.get_allowed_starts(i)) {
+            for (const auto& w : problem.get_workload(i, s)) {
+                if (w.amount < 0.0) non_negative = false;
+            }
+        }
+    }
+
+    if (non_negative) {
+        for (size_t i = 0; i < n; ++i) {
+            filter(i, [&](int s) {
+                for (const auto& w : problem.get_workload(i, s)) {
+                    if (w.amount > problem.get_resource_upper_bound(w.resource)[w.period] + tolerance) return false;
+                }
+                return true;
+            });
+        }
+    }
+
+    // Rule (ii): the intervention covers a season period in which its exclusion partner is
+    // ongoing for all of its allowed start times (the forced window of the partner)
+    auto forced_window = [&](size_t i) {
+        int begin = 1;
+        int end = problem.get_T();
+        for (int s : problem.get_allowed_starts(i)) {
+            begin = std::max(begin, s);
+            end = std::min(end, s + problem.get_delta(i, s) - 1);
+        }
+        return std::make_pair(begin, end);
+    };
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        ++stats.rounds;
+
+        for (const auto& exclusion : problem.get_exclusions()) {
+            for (int side = 0; side < 2; ++side) {
+                const size_t i = (side == 0 ? exclusion.intervention_1 : exclusion.intervention_2);
+                const size_t partner = (side == 0 ? exclusion.intervention_2 : exclusion.intervention_1);
+                if (i == partner) continue;
+                const auto [forced_begin, forced_end] = forced_window(partner);
+
+                // Season periods in which the partner is always ongoing
+                std::vector<int> forbidden;
+                for (int t : exclusion.season) {
+                    if (t >= forced_begin && t <= forced_end) forbidden.push_back(t);
+                }
+                if (forbidden.empty()) continue;
+
+                changed |= filter(i, [&](int s) {
+                    const int end = s + problem.get_delta(i, s) - 1;
+                    for (int t : forbidden) {
+                        if (t >= s && t <= end) return false;
+                    }
+                    return true;
+                });
+            }
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        stats.starts_after += problem.get_allowed_starts(i).size();
+    }
+
+    return stats;
+}
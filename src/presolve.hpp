@@ -0,0 +1,38 @@
+#ifndef INCLUDE_MPP_PRESOLVE_HPP_
+#define INCLUDE_MPP_PRESOLVE_HPP_
+
+#include <cstddef>
+#include <problem.hpp>
+
+
+namespace mpp {
+
+    /**
+     * @brief Statistics of the start time domain presolve.
+     * @param starts_before Total number of allowed start times before the presolve.
+     * @param starts_after Total number of allowed start times after the presolve.
+     * @param rounds Number of rounds until no more start times could be removed.
+     */
+    struct presolve_stats_t {
+        size_t starts_before = 0;
+        size_t starts_after = 0;
+        int rounds = 0;
+    };
+
+
+    /**
+     * @brief Remove provably infeasible start times from the domain of each intervention.
+     * @details A start time is removed if (i) the workload of the intervention alone exceeds the upper
+     * bound of a resource in some period it covers (only if no workload is negative), or (ii) the
+     * intervention would cover a season period of an exclusion in which its partner is ongoing for
+     * all of the partner's allowed start times. Rule (ii) is applied until a fixed point is reached.
+     * A start time is never removed if it is the last one allowed for its intervention.
+     * @param problem The maintenance planning problem instance (its allowed start times are restricted).
+     * @return The presolve statistics.
+     */
+    presolve_stats_t presolve(problem_t& problem);
+
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_PRESOLVE_HPP_
@@ -1,14 +1,37 @@
 #include <problem.hpp>
+#include <risk_table.hpp>
+#include <stats.hpp>
+#include <trace.hpp>
 #include <fstream>
 #include <string>
 #include <map>
 #include <vector>
 #include <algorithm>
 #include <cassert>
+#include <numeric>
+#include <stdexcept>
+#include <sstream>
 
 
-mpp::problem_t::problem_t(const std::string& filename) : data_(json::parse(std::ifstream(filename))) {
-    for (auto& [intervention_name, intervention_data] : data_[params::INTERVENTIONS].items()) {
+namespace {
+
+    // Parse the JSON file of an instance
+    mpp::json read_instance(const std::string& filename) {
+        mpp::stats::scoped_timer_t timer(mpp::stats::phase_t::load);
+        mpp::trace::span_t span("load");
+        return mpp::json::parse(std::ifstream(filename));
+    }
+
+} // namespace
+
+
+mpp::problem_t::problem_t(const std::string& filename) : problem_t(read_instance(filename)) {
+    // Does nothing here.
+}
+
+
+mpp::problem_t::problem_t(json data) {
+    for (auto& [intervention_name, intervention_data] : data[params::INTERVENTIONS].items()) {
 
         // Get intervention names
         intervention_names_.push_back(intervention_name);
@@ -20,20 +43,167 @@ mpp::problem_t::problem_t(const std::string& filename) : data_(json::parse(std::
 
         // Fix delta array values from string to a proper numerical type.
         for (int i = 0; i < intervention_data[params::INTERVENTION_DELTA].size(); ++i) {
-            if (!intervention_data[params::INTERVENTION_DELTA][0].is_number()) {
-                intervention_data[params::INTERVENTION_DELTA][0] = std::stoi(intervention_data[params::INTERVENTION_DELTA][0].template get<std::string>());
+            if (!intervention_data[params::INTERVENTION_DELTA][i].is_number()) {
+                intervention_data[params::INTERVENTION_DELTA][i] = std::stoi(intervention_data[params::INTERVENTION_DELTA][i].template get<std::string>());
             }
         }
     }
 
     // Fix seasons data to a proper numerical type.
-    for (auto& [season_name, season_data] : data_[params::SEASONS].items()) {
+    for (auto& [season_name, season_data] : data[params::SEASONS].items()) {
         for (int i = 0; i < season_data.size(); ++i) {
             if (!season_data[i].is_number()) {
                 season_data[i] = std::stoi(season_data[i].template get<std::string>());
             }
         }
     }
+
+    // The raw data is shared (read-only) by the copies of the problem
+    data_ = std::make_shared<const json>(std::move(data));
+
+    // Compile the instance data into flat structures
+    compile();
+}
+
+
+void mpp::problem_t::compile() {
+    stats::scoped_timer_t timer(stats::phase_t::compile);
+    trace::span_t span("compile");
+    const json& data = *data_;
+    const json& interventions = data[params::INTERVENTIONS];
+    const json& resources = data[params::RESOURCES];
+    const json& scenarios_number = data[params::SCENARIOS_NUMBER];
+    const json& seasons = data[params::SEASONS];
+    T_ = data[params::T].template get<int>();
+
+    // Resources and their bounds
+    std::map<std::string, int> resource_index;
+    for (const auto& [resource_name, resource_data] : resources.items()) {
+        resource_index[resource_name] = static_cast<int>(resource_names_.size());
+        resource_names_.push_back(resource_name);
+        resource_lower_bound_.push_back(resource_data[params::RESOURCE_LOWER_BOUND].template get< std::vector<double> >());
+        resource_upper_bound_.push_back(resource_data[params::RESOURCE_UPPER_BOUND].template get< std::vector<double> >());
+    }
+
+    // Start time limit, duration, workload and mean risk of each intervention by start time
+    std::map<std::string, int> intervention_index;
+    for (const auto& intervention_name : intervention_names_) {
+        const json& intervention_data = interventions[intervention_name];
+        const json& intervention_risk = intervention_data[params::INTERVENTION_RISK];
+        const json& intervention_workload = intervention_data[params::INTERVENTION_RESOURCE_WORKLOAD];
+        int t_max = intervention_data[params::INTERVENTION_TMAX].template get<int>();
+
+        intervention_index[intervention_name] = static_cast<int>(tmax_.size());
+        tmax_.push_back(t_max);
+        delta_.emplace_back(intervention_data[params::INTERVENTION_DELTA].template get< std::vector<int> >());
+        workload_row_.push_back(workload_offset_.size());
+        mean_risk_.emplace_back(t_max, 0.0);
+        allowed_starts_.emplace_back(t_max);
+        std::iota(allowed_starts_.back().begin(), allowed_starts_.back().end(), 1);
+
+        for (int start_time = 1; start_time <= t_max; ++start_time) {
+            const std::string start_time_key = std::to_string(start_time);
+            int delta = delta_.back()[start_time - 1];
+            workload_offset_.push_back(workload_.size());
+
+            for (int t = start_time; t < start_time + delta && t <= T_; ++t) {
+                const std::string period_key = std::to_string(t);
+
+                // Mean risk (contribution to the first objective)
+                const auto& risk_at_period = intervention_risk.find(period_key);
+                if (risk_at_period != intervention_risk.end()) {
+                    const auto& risk = risk_at_period->find(start_time_key);
+                    if (risk != risk_at_period->end()) {
+                        double sum = 0.0;
+                        for (const auto& r : *risk) {
+                            sum += r.template get<double>();
+                        }
+                        mean_risk_.back()[start_time - 1] += sum / (scenarios_number[t - 1].template get<int>() * T_);
+                    }
+                }
+
+                // Resources workload
+                for (const auto& [resource_name, resource_workload] : intervention_workload.items()) {
+                    const auto& workload_at_period = resource_workload.find(period_key);
+                    if (workload_at_period != resource_workload.end()) {
+                        const auto& workload = workload_at_period->find(start_time_key);
+                        if (workload != workload_at_period->end()) {
+                            workload_.push_back({ resource_index[resource_name], t - 1, workload->template get<double>() });
+                        }
+                    }
+                }
+            }
+        }
+    }
+    workload_row_.push_back(workload_offset_.size());
+    workload_offset_.push_back(workload_.size());
+
+    // Transposed workloads: count the contributors of each (resource, period), then fill them in order
+    contributor_offset_.assign(resource_names_.size() * T_ + 1, 0);
+    for (const auto& workload : workload_) {
+        ++contributor_offset_[static_cast<size_t>(workload.resource) * T_ + workload.period + 1];
+    }
+    std::partial_sum(contributor_offset_.begin(), contributor_offset_.end(), contributor_offset_.begin());
+
+    contributor_.resize(workload_.size());
+    std::vector<size_t> next(contributor_offset_.begin(), contributor_offset_.end() - 1);
+    for (size_t i = 0; i < intervention_names_.size(); ++i) {
+        for (int start_time = 1; start_time <= tmax_[i]; ++start_time) {
+            for (const auto& workload : get_workload(i, start_time)) {
+                const size_t row = static_cast<size_t>(workload.resource) * T_ + workload.period;
+                contributor_[next[row]++] = { static_cast<int>(i), start_time, workload.amount };
+            }
+        }
+    }
+
+    // Exclusions
+    for (const auto& [exclusion_name, exclusion_data] : data[params::EXCLUSIONS].items()) {
+        exclusions_.push_back({ intervention_index[exclusion_data[0].template get<std::string>()],
+                                intervention_index[exclusion_data[1].template get<std::string>()],
+                                seasons[exclusion_data[2].template get<std::string>()].template get< std::vector<int> >() });
+    }
+
+    // Exclusion index: bitsets of the periods (bit t for period t) covered by each intervention and start time
+    // and of the season of each exclusion, and the exclusions involving each intervention
+    int last_period = T_;
+    for (const auto& exclusion : exclusions_) {
+        for (int t : exclusion.season) last_period = std::max(last_period, t);
+    }
+    period_words_ = static_cast<size_t>(last_period) / 64 + 1;
+
+    auto set_bit = [](std::uint64_t* bitset, int t) { bitset[t / 64] |= (std::uint64_t(1) << (t % 64)); };
+
+    coverage_offset_.clear();
+    coverage_.clear();
+    for (size_t i = 0; i < intervention_names_.size(); ++i) {
+        coverage_offset_.push_back(coverage_.size());
+        coverage_.resize(coverage_.size() + tmax_[i] * period_words_, 0);
+        for (int start_time = 1; start_time <= tmax_[i]; ++start_time) {
+            std::uint64_t* coverage = &coverage_[coverage_offset_[i] + (start_time - 1) * period_words_];
+            const int end_time = std::min(start_time + delta_[i][start_time - 1] - 1, last_period);
+            for (int t = start_time; t <= end_time; ++t) set_bit(coverage, t);
+        }
+    }
+
+    season_.assign(exclusions_.size() * period_words_, 0);
+    intervention_exclusions_.assign(intervention_names_.size(), {});
+    for (size_t e = 0; e < exclusions_.size(); ++e) {
+        for (int t : exclusions_[e].season) {
+            if (t >= 1) set_bit(&season_[e * period_words_], t);
+        }
+        intervention_exclusions_[exclusions_[e].intervention_1].push_back(e);
+        if (exclusions_[e].intervention_2 != exclusions_[e].intervention_1) {
+            intervention_exclusions_[exclusions_[e].intervention_2].push_back(e);
+        }
+    }
+
+    // Exclusion periods, numbered by exclusion and period: the first one of each word of the seasons
+    season_rank_.resize(season_.size());
+    exclusion_periods_ = 0;
+    for (size_t w = 0; w < season_.size(); ++w) {
+        season_rank_[w] = exclusion_periods_;
+        exclusion_periods_ += std::bitset<64>(season_[w]).count();
+    }
 }
 
 
@@ -42,31 +212,74 @@ mpp::problem_t::~problem_t() {
 }
 
 
+void mpp::problem_t::restrict_allowed_starts(size_t intervention, const std::vector<int>& allowed_starts) {
+    if (allowed_starts.empty()) {
+        throw std::invalid_argument("Intervention " + intervention_names_[intervention] + " must have at least one allowed start time.");
+    }
+
+    allowed_starts_[intervention] = allowed_starts;
+    std::sort(allowed_starts_[intervention].begin(), allowed_starts_[intervention].end());
+}
+
+
+void mpp::problem_t::set_resource_bounds(size_t resource, const std::vector<double>& lower_bound, const std::vector<double>& upper_bound) {
+    if (lower_bound.size() != static_cast<size_t>(T_) || upper_bound.size() != static_cast<size_t>(T_)) {
+        throw std::invalid_argument("The bounds of Resource " + resource_names_[resource] + " must have " + std::to_string(T_) + " values.");
+    }
+
+    resource_lower_bound_[resource] = lower_bound;
+    resource_upper_bound_[resource] = upper_bound;
+}
+
+
 std::tuple<mpp::objective_t, mpp::risk_metric_t, mpp::constraints_t>
 mpp::problem_t::evaluate(const mpp::solution_t& solution) const {
 
-    // Get some data from the problem
-    constexpr double tolerance = 1e-5;
-    int t_max = data_[params::T].template get<int>();
-    double quantil = data_[params::QUANTILE].template get<double>();
-    const json& interventions = data_[params::INTERVENTIONS];
-    const json& resources = data_[params::RESOURCES];
-    const json& scenarios_number = data_[params::SCENARIOS_NUMBER];
-    const json& exclusions = data_[params::EXCLUSIONS];
-    const json& seasons = data_[params::SEASONS];
+    stats::count(stats::counter_t::evaluations);
 
     // Asserts that all interventions must have a valid start time
-    for (const auto& intervention_name : intervention_names_) {
+    std::vector<int> start_times(intervention_names_.size());
+    for (size_t i = 0; i < intervention_names_.size(); ++i) {
 
         // Check if the intervention is in the solution
-        assert(solution.find(intervention_name) != solution.end());
+        assert(solution.find(intervention_names_[i]) != solution.end());
 
         // Check if the start time is valid
-        int start_time = solution.at(intervention_name);
-        int start_time_max = interventions[intervention_name][params::INTERVENTION_TMAX].template get<int>();
-        assert(start_time >= 1 && start_time <= start_time_max);
+        int start_time = solution.at(intervention_names_[i]);
+        assert(start_time >= 1 && start_time <= tmax_[i]);
+        start_times[i] = start_time;
+    }
+
+    return score(start_times, nullptr);
+}
+
+
+std::tuple<mpp::objective_t, mpp::risk_metric_t, mpp::constraints_t>
+mpp::problem_t::evaluate(const std::vector<int>& start_times, const mpp::risk_table_t& risk_table) const {
+
+    stats::count(stats::counter_t::evaluations);
+
+    // Asserts that all interventions must have a valid start time
+    assert(start_times.size() == intervention_names_.size());
+    for (size_t i = 0; i < intervention_names_.size(); ++i) {
+        assert(start_times[i] >= 1 && start_times[i] <= tmax_[i]);
     }
-    
+
+    return score(start_times, &risk_table);
+}
+
+
+std::tuple<mpp::objective_t, mpp::risk_metric_t, mpp::constraints_t>
+mpp::problem_t::score(const std::vector<int>& start_times, const mpp::risk_table_t* risk_table) const {
+
+    // Get some data from the problem
+    constexpr double tolerance = 1e-5;
+    const json& data = *data_;
+    int t_max = data[params::T].template get<int>();
+    double quantil = data[params::QUANTILE].template get<double>();
+    const json& interventions = data[params::INTERVENTIONS];
+    const json& scenarios_number = data[params::SCENARIOS_NUMBER];
+
     // Some temporary structures to evaluate the solution
     std::vector<double> mean_risk_by_period(t_max, 0.0);
 
@@ -76,90 +289,69 @@ mpp::problem_t::evaluate(const mpp::solution_t& solution) const {
         risk.emplace_back(scenarios_number[t].template get<int>(), 0.0);
     }
 
-    std::map< std::string, std::vector<double> > resource_usage;
-    for (const auto& [resource_name, resource_data] : resources.items()) {
-        resource_usage.emplace(resource_name, std::vector<double>(t_max, 0.0));
-    }
+    std::vector<double> resource_usage(resource_names_.size() * t_max, 0.0);   // Resource x period
 
-    // Iterate over each intervention to calculate the risk and resource usage
-    for (const auto& [intervention_name, intervention_data] : interventions.items()) {
-        const json& intervention_risk = intervention_data[params::INTERVENTION_RISK];
-        int start_time = solution.at(intervention_name);
-        int delta = intervention_data[params::INTERVENTION_DELTA][start_time - 1].template get<int>();
-        
-        // Risk associated with the intervention
-        for (int t = start_time - 1; t < start_time + delta - 1; ++t) {
-            for (const auto& [i, additional_risk] : intervention_risk[std::to_string(t + 1)][std::to_string(start_time)].items()) {
-                risk[t][std::stoi(i)] += additional_risk.template get<double>();
-                mean_risk_by_period[t] += additional_risk.template get<double>();
-            }
+    // Iterate over each intervention to calculate the risk (exactly, from the instance data, or from the
+    // reduced-precision risk table)
+    if (risk_table != nullptr) {
+        for (size_t i = 0; i < intervention_names_.size(); ++i) {
+            risk_table->add(i, start_times[i], risk);
         }
+        for (int t = 0; t < t_max; ++t) {
+            mean_risk_by_period[t] = std::accumulate(risk[t].begin(), risk[t].end(), 0.0);
+        }
+    } else {
+        for (size_t i = 0; i < intervention_names_.size(); ++i) {
+            const json& intervention_risk = interventions[intervention_names_[i]][params::INTERVENTION_RISK];
+            int start_time = start_times[i];
+            int delta = delta_[i][start_time - 1];
 
-        // Resource usage associated with the intervention
-        for (const auto& [resource_name, intervention_workload] : intervention_data[params::INTERVENTION_RESOURCE_WORKLOAD].items()) {
+            // Risk associated with the intervention
             for (int t = start_time - 1; t < start_time + delta - 1; ++t) {
-
-                // Check if the resource is used by at time period t when intervention starts at start_time
-                const auto& workload_at_period = intervention_workload.find(std::to_string(t + 1));
-                if (workload_at_period != intervention_workload.end()) {
-                    const auto& workload = workload_at_period->find(std::to_string(start_time));
-                    if (workload != workload_at_period->end()) {
-                        resource_usage[resource_name][t] += workload->template get<double>();
-                    }
+                for (const auto& [s, additional_risk] : intervention_risk[std::to_string(t + 1)][std::to_string(start_time)].items()) {
+                    risk[t][std::stoi(s)] += additional_risk.template get<double>();
+                    mean_risk_by_period[t] += additional_risk.template get<double>();
                 }
             }
         }
+    }
 
+    // Resource usage (from the compiled workloads)
+    for (size_t i = 0; i < intervention_names_.size(); ++i) {
+        for (const auto& workload : get_workload(i, start_times[i])) {
+            resource_usage[static_cast<size_t>(workload.resource) * t_max + workload.period] += workload.amount;
+        }
     }
 
     // Check resources usage constraints
     double resource_count_violation = 0.0;
     double resource_sum_violation = 0.0;
-    for (const auto& [resource_name, resource_data] : resources.items()) {
-        const auto& lower_bound = resource_data[params::RESOURCE_LOWER_BOUND];
-        const auto& upper_bound = resource_data[params::RESOURCE_UPPER_BOUND];
+    // (the bounds are read from the compiled data, as they may have been changed after loading)
+    for (size_t r = 0; r < resource_names_.size(); ++r) {
+        const double* usage = &resource_usage[r * t_max];
+        const auto& lower_bound = resource_lower_bound_[r];
+        const auto& upper_bound = resource_upper_bound_[r];
         for (int t = 0; t < t_max; ++t) {
 
             // Check upper bound
-            if (resource_usage[resource_name][t] > upper_bound[t].template get<double>() + tolerance) {
-                resource_sum_violation += resource_usage[resource_name][t] - upper_bound[t].template get<double>();
+            if (usage[t] > upper_bound[t] + tolerance) {
+                resource_sum_violation += usage[t] - upper_bound[t];
                 resource_count_violation += 1.0;
             }
 
             // Check lower bound
-            if (resource_usage[resource_name][t] < lower_bound[t].template get<double>() - tolerance) {
-                resource_sum_violation += lower_bound[t].template get<double>() - resource_usage[resource_name][t];
+            if (usage[t] < lower_bound[t] - tolerance) {
+                resource_sum_violation += lower_bound[t] - usage[t];
                 resource_count_violation += 1.0;
             }
 
         }
     }
 
-    // Check exclusions constraints
+    // Check exclusions constraints (season periods in which both interventions are active, from the exclusion index)
     double exclusions_violation = 0.0;
-    for (const auto& [exclusion_name, exclusion_data] : exclusions.items()) {
-        const auto& intervention_1_name = exclusion_data[0].template get<std::string>();
-        const auto& intervention_2_name = exclusion_data[1].template get<std::string>();
-        const auto& season = seasons[exclusion_data[2].template get<std::string>()];
-        const auto& intervention_1 = interventions[intervention_1_name];
-        const auto& intervention_2 = interventions[intervention_2_name];
-
-        // Find the intersection of the two interventions
-        int start_time_1 = solution.at(intervention_1_name);
-        int start_time_2 = solution.at(intervention_2_name);
-        int delta_1 = intervention_1[params::INTERVENTION_DELTA][start_time_1 - 1].template get<int>();
-        int delta_2 = intervention_2[params::INTERVENTION_DELTA][start_time_2 - 1].template get<int>();
-        int end_time_1 = start_time_1 + delta_1 - 1;
-        int end_time_2 = start_time_2 + delta_2 - 1;
-
-        int start = std::max(start_time_1, start_time_2);
-        int end = std::min(end_time_1, end_time_2);
-
-        for (const auto& t : season) {
-            if (t >= start && t <= end) {
-                exclusions_violation += 1.0;
-            }
-        }
+    for (size_t e = 0; e < exclusions_.size(); ++e) {
+        exclusions_violation += get_exclusion_conflicts(e, start_times[exclusions_[e].intervention_1], start_times[exclusions_[e].intervention_2]);
     }
 
     // Compute objective function (mean risk and expected excess)
@@ -181,7 +373,7 @@ mpp::problem_t::evaluate(const mpp::solution_t& solution) const {
     mean_risk /= t_max;
     expected_excess /= t_max;
 
-    double alpha = data_[params::ALPHA].template get<double>();
+    double alpha = data[params::ALPHA].template get<double>();
     double objective = (alpha * mean_risk) + ((1 - alpha) * expected_excess);
 
     // Return objective and constraints values
@@ -190,3 +382,55 @@ mpp::problem_t::evaluate(const mpp::solution_t& solution) const {
              {exclusions_violation, resource_count_violation, resource_sum_violation} };
 
 }
+
+
+mpp::solution_t
+mpp::load_solution(const std::string& filename, std::vector<std::string>* errors) {
+    std::ifstream solution_in(filename);
+    if (!solution_in.is_open()) {
+        throw std::runtime_error("Error opening solution file " + filename + " for reading.");
+    }
+
+    solution_t solution;
+    std::string line;
+    while (std::getline(solution_in, line)) {
+        std::istringstream line_in(line);
+        std::string intervention_name;
+        std::string start_time_str;
+        if (!(line_in >> intervention_name)) continue;  // Skip empty lines
+
+        // Parse the start time as an integer
+        int start_time = 0;
+        size_t parsed = 0;
+        line_in >> start_time_str;
+        try {
+            start_time = std::stoi(start_time_str, &parsed);
+        } catch (...) {
+            parsed = 0;
+        }
+        if (parsed == 0 || parsed != start_time_str.size()) {
+            if (errors) errors->push_back("Unexpected starting time " + start_time_str + " for Intervention " + intervention_name + ". Expect integer value.");
+            continue;
+        }
+
+        // Keep only the first entry of each intervention
+        if (!solution.emplace(intervention_name, start_time).second) {
+            if (errors) errors->push_back("Duplicate entry for Intervention " + intervention_name + ". Only first read value is being considered.");
+        }
+    }
+
+    return solution;
+}
+
+
+void
+mpp::save_solution(const solution_t& solution, const std::string& filename) {
+    std::ofstream solution_out(filename);
+    if (!solution_out.is_open()) {
+        throw std::runtime_error("Error opening solution file " + filename + " for writing.");
+    }
+
+    for (const auto& [intervention_name, start_time] : solution) {
+        solution_out << intervention_name << " " << start_time << std::endl;
+    }
+}
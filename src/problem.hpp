@@ -1,6 +1,10 @@
 #ifndef INCLUDE_MPP_PROBLEM_HPP_
 #define INCLUDE_MPP_PROBLEM_HPP_
 
+#include <bitset>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -32,9 +36,89 @@ namespace params {
     const std::string INTERVENTION_RESOURCE_WORKLOAD = "workload";
 }
 
+/**
+ * @brief Workload of an intervention on a resource at a given period.
+ * @param resource Index of the resource (as in problem_t::get_resource_names()).
+ * @param period Time period (0-based).
+ * @param amount Amount of the resource consumed.
+ */
+struct workload_t {
+    int resource;
+    int period;
+    double amount;
+};
+
+/**
+ * @brief Contribution of an intervention to the usage of a resource at a given period.
+ * @param intervention Index of the intervention.
+ * @param start_time Start time (1-based) of the intervention.
+ * @param amount Amount of the resource consumed.
+ */
+struct contributor_t {
+    int intervention;
+    int start_time;
+    double amount;
+};
+
+/**
+ * @brief Read-only view of a contiguous range of entries of the compiled data.
+ */
+template <typename T>
+class range_t {
+    public:
+    range_t(const T* first, const T* last) : first_(first), last_(last) { }
+    const T* begin() const { return first_; }
+    const T* end() const { return last_; }
+    size_t size() const { return static_cast<size_t>(last_ - first_); }
+    bool empty() const { return first_ == last_; }
+    const T& operator[](size_t k) const { return first_[k]; }
+
+    private:
+    const T* first_;
+    const T* last_;
+};
+
+/**
+ * @brief Exclusion between two interventions during a season.
+ * @param intervention_1 Index of the first intervention.
+ * @param intervention_2 Index of the second intervention.
+ * @param season Time periods (1-based) of the season.
+ */
+struct exclusion_t {
+    int intervention_1;
+    int intervention_2;
+    std::vector<int> season;
+};
+
+class risk_table_t;
+
+/**
+ * @brief Read a solution file (one "<intervention> <start time>" pair per line).
+ * @details Malformed lines and duplicate entries are skipped (only the first entry of an intervention
+ * is kept), and a message describing each of them is appended to errors, if given.
+ * @param filename Path to the solution file.
+ * @param errors Messages about skipped lines (optional).
+ * @return The solution read from the file.
+ */
+solution_t load_solution(const std::string& filename, std::vector<std::string>* errors = nullptr);
+
+/**
+ * @brief Write a solution file (one "<intervention> <start time>" pair per line).
+ * @param solution The solution to write.
+ * @param filename Path to the solution file.
+ */
+void save_solution(const solution_t& solution, const std::string& filename);
+
+/**
+ * @brief Instance of the maintenance planning problem.
+ * @details Copies share the raw instance data (read-only) and own the compiled data, so a copy can be
+ * modified (allowed start times, resource bounds) without reloading the instance.
+ */
 class problem_t {
     public:
     problem_t(const std::string& filename);
+    problem_t(const char* filename) : problem_t(std::string(filename)) { }
+    explicit problem_t(json data);
     ~problem_t();
 
     std::tuple<objective_t, risk_metric_t, constraints_t>
@@ -48,16 +132,126 @@ class problem_t {
     std::tuple<objective_t, risk_metric_t, constraints_t>
     evaluate(const std::vector<int>& start_time, const std::vector<std::string>& intervention_name) const;
 
+    // Evaluation with the scenario risks of a reduced-precision table (see risk_table_t): the objective is
+    // approximate, the constraints are exact
+
+    std::tuple<objective_t, risk_metric_t, constraints_t>
+    evaluate(const std::vector<int>& start_time, const risk_table_t& risk_table) const;
+
     inline
     const json& get_data() const;
 
     inline
     const std::vector<std::string>& get_intervention_names() const;
 
+    // Compiled instance data, indexed by intervention (as in get_intervention_names()),
+    // start time (1-based) and resource (as in get_resource_names())
+
+    inline
+    int get_T() const;
+
+    inline
+    int get_tmax(size_t intervention) const;
+
+    inline
+    int get_delta(size_t intervention, int start_time) const;
+
+    inline
+    const std::vector<std::string>& get_resource_names() const;
+
+    inline
+    const std::vector<double>& get_resource_lower_bound(size_t resource) const;
+
+    inline
+    const std::vector<double>& get_resource_upper_bound(size_t resource) const;
+
+    // Workloads in compressed sparse row (CSR) form: by intervention and start time (ordered by period, then
+    // resource), and transposed, by resource and period (0-based, ordered by intervention, then start time)
+
+    inline
+    range_t<workload_t> get_workload(size_t intervention, int start_time) const;
+
+    inline
+    range_t<contributor_t> get_contributors(size_t resource, int period) const;
+
+    inline
+    double get_mean_risk(size_t intervention, int start_time) const;
+
+    inline
+    const std::vector<exclusion_t>& get_exclusions() const;
+
+    // Exclusion index: the periods covered by each intervention and start time, and the season of each
+    // exclusion, are bitsets, so the conflicts of an exclusion (the season periods in which both
+    // interventions are active) are counted with a few AND and popcount operations
+
+    inline
+    const std::vector<size_t>& get_intervention_exclusions(size_t intervention) const;
+
+    inline
+    int get_exclusion_conflicts(size_t exclusion, int start_time_1, int start_time_2) const;
+
+    // Conflicts of the exclusions involving an intervention at a start time, given the start times of the
+    // other interventions (the ones with start time 0 are not scheduled and are ignored)
+
+    inline
+    double get_exclusion_violations(size_t intervention, int start_time, const std::vector<int>& start_times) const;
+
+    // Exclusion periods: one per exclusion and period of its season, numbered from 0. An intervention at a start
+    // time covers the season periods of its exclusions from its start time to its end time (twice for an
+    // exclusion of the intervention with itself), so the exclusions hold if no exclusion period is covered twice
+
+    inline
+    size_t get_exclusion_periods() const;
+
+    template <typename F>
+    inline
+    void for_each_exclusion_period(size_t intervention, int start_time, F&& f) const;
+
+    // Allowed start times of each intervention (sorted). All start times in [1, tmax] are allowed,
+    // unless they are restricted (e.g., by the presolve).
+
+    inline
+    const std::vector<int>& get_allowed_starts(size_t intervention) const;
+
+    void restrict_allowed_starts(size_t intervention, const std::vector<int>& allowed_starts);
+
+    // Bounds of a resource (one value per period). They replace the bounds of the instance data
+    // in the compiled data and in the evaluation.
+
+    void set_resource_bounds(size_t resource, const std::vector<double>& lower_bound, const std::vector<double>& upper_bound);
+
     private:
-    json data_;
+    std::shared_ptr<const json> data_;
     std::vector<std::string> intervention_names_;
 
+    int T_;
+    std::vector<int> tmax_;
+    std::vector< std::vector<int> > delta_;
+    std::vector<std::string> resource_names_;
+    std::vector< std::vector<double> > resource_lower_bound_;
+    std::vector< std::vector<double> > resource_upper_bound_;
+    std::vector<size_t> workload_row_;                              // First row of each intervention in workload_offset_
+    std::vector<size_t> workload_offset_;                           // First workload of each (intervention, start time)
+    std::vector<workload_t> workload_;
+    std::vector<size_t> contributor_offset_;                        // First contributor of each (resource, period)
+    std::vector<contributor_t> contributor_;
+    std::vector< std::vector<double> > mean_risk_;
+    std::vector<exclusion_t> exclusions_;
+    std::vector< std::vector<int> > allowed_starts_;
+
+    size_t period_words_ = 0;                                       // 64-bit words of a bitset of periods
+    std::vector<size_t> coverage_offset_;                           // First word of each intervention in coverage_
+    std::vector<std::uint64_t> coverage_;                           // Periods covered by intervention and start time
+    std::vector<std::uint64_t> season_;                             // Season periods of each exclusion
+    std::vector< std::vector<size_t> > intervention_exclusions_;    // Exclusions involving each intervention
+    std::vector<size_t> season_rank_;                               // First exclusion period of each season word
+    size_t exclusion_periods_ = 0;
+
+    void compile();
+
+    std::tuple<objective_t, risk_metric_t, constraints_t>
+    score(const std::vector<int>& start_times, const risk_table_t* risk_table) const;
+
 };
 
 }
@@ -65,14 +259,14 @@ class problem_t {
 
 std::tuple<mpp::objective_t, mpp::risk_metric_t, mpp::constraints_t>
 mpp::problem_t::evaluate(const std::vector<int>& start_time) const {
-    evaluate(start_time, intervention_names_);
+    return evaluate(start_time, intervention_names_);
 }
 
 
 std::tuple<mpp::objective_t, mpp::risk_metric_t, mpp::constraints_t>
 mpp::problem_t::evaluate(const std::vector<int>& start_time, const std::vector<std::string>& intervention_name) const {
     solution_t solution;
-    for (int i = 0; i < intervention_name.size(); ++i) {
+    for (size_t i = 0; i < intervention_name.size(); ++i) {
         solution.insert({intervention_name[i], start_time[i]});
     }
 
@@ -81,7 +275,7 @@ mpp::problem_t::evaluate(const std::vector<int>& start_time, const std::vector<s
 
 const nlohmann::json&
 mpp::problem_t::get_data() const { 
-    return data_;
+    return *data_;
 }
 
 const std::vector<std::string>& 
@@ -90,4 +284,115 @@ mpp::problem_t::get_intervention_names() const {
 }
 
 
+int
+mpp::problem_t::get_T() const {
+    return T_;
+}
+
+int
+mpp::problem_t::get_tmax(size_t intervention) const {
+    return tmax_[intervention];
+}
+
+int
+mpp::problem_t::get_delta(size_t intervention, int start_time) const {
+    return delta_[intervention][start_time - 1];
+}
+
+const std::vector<std::string>&
+mpp::problem_t::get_resource_names() const {
+    return resource_names_;
+}
+
+const std::vector<double>&
+mpp::problem_t::get_resource_lower_bound(size_t resource) const {
+    return resource_lower_bound_[resource];
+}
+
+const std::vector<double>&
+mpp::problem_t::get_resource_upper_bound(size_t resource) const {
+    return resource_upper_bound_[resource];
+}
+
+mpp::range_t<mpp::workload_t>
+mpp::problem_t::get_workload(size_t intervention, int start_time) const {
+    const size_t row = workload_row_[intervention] + static_cast<size_t>(start_time - 1);
+    return { workload_.data() + workload_offset_[row], workload_.data() + workload_offset_[row + 1] };
+}
+
+mpp::range_t<mpp::contributor_t>
+mpp::problem_t::get_contributors(size_t resource, int period) const {
+    const size_t row = resource * static_cast<size_t>(T_) + static_cast<size_t>(period);
+    return { contributor_.data() + contributor_offset_[row], contributor_.data() + contributor_offset_[row + 1] };
+}
+
+double
+mpp::problem_t::get_mean_risk(size_t intervention, int start_time) const {
+    return mean_risk_[intervention][start_time - 1];
+}
+
+const std::vector<mpp::exclusion_t>&
+mpp::problem_t::get_exclusions() const {
+    return exclusions_;
+}
+
+const std::vector<size_t>&
+mpp::problem_t::get_intervention_exclusions(size_t intervention) const {
+    return intervention_exclusions_[intervention];
+}
+
+int
+mpp::problem_t::get_exclusion_conflicts(size_t exclusion, int start_time_1, int start_time_2) const {
+    const std::uint64_t* coverage_1 = &coverage_[coverage_offset_[exclusions_[exclusion].intervention_1] + (start_time_1 - 1) * period_words_];
+    const std::uint64_t* coverage_2 = &coverage_[coverage_offset_[exclusions_[exclusion].intervention_2] + (start_time_2 - 1) * period_words_];
+    const std::uint64_t* season = &season_[exclusion * period_words_];
+    int conflicts = 0;
+    for (size_t w = 0; w < period_words_; ++w) {
+        conflicts += static_cast<int>(std::bitset<64>(coverage_1[w] & coverage_2[w] & season[w]).count());
+    }
+    return conflicts;
+}
+
+double
+mpp::problem_t::get_exclusion_violations(size_t intervention, int start_time, const std::vector<int>& start_times) const {
+    double violations = 0.0;
+    for (size_t e : intervention_exclusions_[intervention]) {
+        const auto& exclusion = exclusions_[e];
+        const bool first = (static_cast<size_t>(exclusion.intervention_1) == intervention);
+        const int partner_start_time = start_times[first ? exclusion.intervention_2 : exclusion.intervention_1];
+        if (partner_start_time == 0) continue;
+        violations += first ? get_exclusion_conflicts(e, start_time, partner_start_time)
+                            : get_exclusion_conflicts(e, partner_start_time, start_time);
+    }
+    return violations;
+}
+
+size_t
+mpp::problem_t::get_exclusion_periods() const {
+    return exclusion_periods_;
+}
+
+template <typename F>
+void
+mpp::problem_t::for_each_exclusion_period(size_t intervention, int start_time, F&& f) const {
+    const std::uint64_t* coverage = &coverage_[coverage_offset_[intervention] + (start_time - 1) * period_words_];
+    for (size_t e : intervention_exclusions_[intervention]) {
+        const std::uint64_t* season = &season_[e * period_words_];
+        const int roles = (exclusions_[e].intervention_1 == exclusions_[e].intervention_2) ? 2 : 1;
+        for (size_t w = 0; w < period_words_; ++w) {
+            for (std::uint64_t bits = coverage[w] & season[w]; bits != 0; bits &= bits - 1) {
+                const std::uint64_t below = (bits & (~bits + 1)) - 1;     // Season bits before the lowest one
+                const size_t exclusion_period = season_rank_[e * period_words_ + w] + std::bitset<64>(season[w] & below).count();
+                for (int role = 0; role < roles; ++role) f(exclusion_period);
+            }
+        }
+    }
+}
+
+const std::vector<int>&
+mpp::problem_t::get_allowed_starts(size_t intervention) const {
+    return allowed_starts_[intervention];
+}
+
+
 #endif // INCLUDE_MPP_PROBLEM_HPP_
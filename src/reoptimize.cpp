@@ -0,0 +1,100 @@
+#include <reoptimize.hpp>
+#include <algorithm>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+std::vector<bool>
+mpp::affected_interventions(const mpp::problem_t& previous, const mpp::problem_t& problem) {
+
+    const json& data = problem.get_data();
+    const json& previous_data = previous.get_data();
+    const auto& intervention_names = problem.get_intervention_names();
+    const size_t n = intervention_names.size();
+    std::vector<bool> affected(n, false);
+
+    // Global parameters
+    for (const auto& param : { params::T, params::SCENARIOS_NUMBER, params::QUANTILE, params::ALPHA }) {
+        if (previous_data[param] != data[param]) {
+            return std::vector<bool>(n, true);
+        }
+    }
+
+    // New or changed interventions
+    const json& previous_interventions = previous_data[params::INTERVENTIONS];
+    for (size_t i = 0; i < n; ++i) {
+        const auto& previous_intervention = previous_interventions.find(intervention_names[i]);
+        if (previous_intervention == previous_interventions.end() ||
+            *previous_intervention != data[params::INTERVENTIONS][intervention_names[i]]) {
+            affected[i] = true;
+        }
+    }
+
+    // Interventions with a workload on a resource whose bounds changed
+    const json& previous_resources = previous_data[params::RESOURCES];
+    for (const auto& [resource_name, resource_data] : data[params::RESOURCES].items()) {
+        const auto& previous_resource = previous_resources.find(resource_name);
+        if (previous_resource != previous_resources.end() && *previous_resource == resource_data) continue;
+
+        for (size_t i = 0; i < n; ++i) {
+            const json& workload = data[params::INTERVENTIONS][intervention_names[i]][params::INTERVENTION_RESOURCE_WORKLOAD];
+            if (workload.find(resource_name) != workload.end()) affected[i] = true;
+        }
+    }
+
+    // Interventions of new or changed exclusions (compared by intervention names and season periods)
+    using exclusion_key_t = std::tuple<std::string, std::string, std::vector<int>>;
+    auto make_key = [](const std::string& name_1, const std::string& name_2, std::vector<int> season) {
+        std::sort(season.begin(), season.end());
+        return (name_1 < name_2) ? exclusion_key_t(name_1, name_2, season) : exclusion_key_t(name_2, name_1, season);
+    };
+
+    std::set<exclusion_key_t> previous_exclusions;
+    const auto& previous_names = previous.get_intervention_names();
+    for (const auto& exclusion : previous.get_exclusions()) {
+        previous_exclusions.insert(make_key(previous_names[exclusion.intervention_1], previous_names[exclusion.intervention_2], exclusion.season));
+    }
+
+    for (const auto& exclusion : problem.get_exclusions()) {
+        const auto key = make_key(intervention_names[exclusion.intervention_1], intervention_names[exclusion.intervention_2], exclusion.season);
+        if (previous_exclusions.find(key) == previous_exclusions.end()) {
+            affected[exclusion.intervention_1] = true;
+            affected[exclusion.intervention_2] = true;
+        }
+    }
+
+    // Exclusion partners of the affected interventions
+    std::vector<bool> partners(affected);
+    for (const auto& exclusion : problem.get_exclusions()) {
+        if (affected[exclusion.intervention_1]) partners[exclusion.intervention_2] = true;
+        if (affected[exclusion.intervention_2]) partners[exclusion.intervention_1] = true;
+    }
+
+    return partners;
+}
+
+
+size_t
+mpp::restrict_to_affected(mpp::problem_t& problem, const mpp::problem_t& previous, const mpp::solution_t& initial) {
+
+    const auto& intervention_names = problem.get_intervention_names();
+    const std::vector<bool> affected = affected_interventions(previous, problem);
+
+    size_t fixed = 0;
+    for (size_t i = 0; i < intervention_names.size(); ++i) {
+        if (affected[i]) continue;
+
+        const auto& it = initial.find(intervention_names[i]);
+        if (it == initial.end()) continue;
+
+        const auto& allowed_starts = problem.get_allowed_starts(i);
+        if (std::binary_search(allowed_starts.begin(), allowed_starts.end(), it->second)) {
+            problem.restrict_allowed_starts(i, { it->second });
+            ++fixed;
+        }
+    }
+
+    return fixed;
+}
@@ -0,0 +1,38 @@
+#ifndef INCLUDE_MPP_REOPTIMIZE_HPP_
+#define INCLUDE_MPP_REOPTIMIZE_HPP_
+
+#include <cstddef>
+#include <vector>
+#include <problem.hpp>
+
+
+namespace mpp {
+
+    /**
+     * @brief Interventions affected by the changes between two versions of an instance.
+     * @details An intervention is affected if it is new or its data (tmax, durations, risk, workload)
+     * changed, if it has a workload on a resource whose bounds changed, or if it belongs to an exclusion
+     * that is new or changed. The exclusion partners of the affected interventions are also affected,
+     * so that they can make room for them. If a global parameter (horizon, scenarios, quantile or alpha)
+     * changed, all interventions are affected.
+     * @param previous The previous version of the instance.
+     * @param problem The current version of the instance.
+     * @return Whether each intervention of problem (in the order of get_intervention_names()) is affected.
+     */
+    std::vector<bool> affected_interventions(const problem_t& previous, const problem_t& problem);
+
+    /**
+     * @brief Restrict the search to the interventions affected by the changes of an instance.
+     * @details Each intervention that is not affected is fixed at its start time in the initial
+     * solution, if that start time is allowed.
+     * @param problem The current version of the instance (its allowed start times are restricted).
+     * @param previous The previous version of the instance.
+     * @param initial The solution of the previous version of the instance.
+     * @return Number of interventions fixed.
+     */
+    size_t restrict_to_affected(problem_t& problem, const problem_t& previous, const solution_t& initial);
+
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_REOPTIMIZE_HPP_
@@ -0,0 +1,107 @@
+#include <risk_table.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+
+mpp::risk_precision_t
+mpp::parse_risk_precision(const std::string& name) {
+    if (name == "float64") return risk_precision_t::float64;
+    if (name == "float32") return risk_precision_t::float32;
+    if (name == "int16") return risk_precision_t::int16;
+    throw std::invalid_argument("Unknown risk precision " + name + " (expected float64, float32 or int16).");
+}
+
+
+mpp::risk_table_t::risk_table_t(const mpp::problem_t& problem, risk_precision_t precision) : precision_(precision) {
+    if (precision == risk_precision_t::float64) {
+        throw std::invalid_argument("The risk table stores the scenario risks in reduced precision (float32 or int16).");
+    }
+
+    const json& interventions = problem.get_data()[params::INTERVENTIONS];
+    const auto& intervention_names = problem.get_intervention_names();
+    const int T = problem.get_T();
+    constexpr double int16_max = std::numeric_limits<std::int16_t>::max();
+
+    std::vector<double> values;
+    for (size_t i = 0; i < intervention_names.size(); ++i) {
+        const json& intervention_risk = interventions[intervention_names[i]][params::INTERVENTION_RISK];
+        start_.push_back(row_.size());
+
+        for (int start_time = 1; start_time <= problem.get_tmax(i); ++start_time) {
+            const std::string start_time_key = std::to_string(start_time);
+            row_.push_back(offset_.size());
+
+            for (int t = start_time; t < start_time + problem.get_delta(i, start_time) && t <= T; ++t) {
+                const size_t offset = std::max(float32_.size(), int16_.size());
+                offset_.push_back(offset);
+
+                // Scenario risks of the row (none if the instance does not define them)
+                values.clear();
+                const auto& risk_at_period = intervention_risk.find(std::to_string(t));
+                if (risk_at_period != intervention_risk.end()) {
+                    const auto& risk = risk_at_period->find(start_time_key);
+                    if (risk != risk_at_period->end()) {
+                        for (const auto& r : *risk) values.push_back(r.template get<double>());
+                    }
+                }
+
+                if (precision_ == risk_precision_t::float32) {
+                    float32_.insert(float32_.end(), values.begin(), values.end());
+                } else {
+                    double largest = 0.0;
+                    for (double v : values) largest = std::max(largest, std::abs(v));
+                    const double scale = largest / int16_max;
+                    scale_.push_back(scale);
+                    for (double v : values) {
+                        int16_.push_back(static_cast<std::int16_t>(scale > 0.0 ? std::lround(v / scale) : 0));
+                    }
+                }
+            }
+        }
+    }
+    start_.push_back(row_.size());
+    row_.push_back(offset_.size());
+    offset_.push_back(std::max(float32_.size(), int16_.size()));
+}
+
+
+mpp::risk_precision_t
+mpp::risk_table_t::precision() const {
+    return precision_;
+}
+
+
+size_t
+mpp::risk_table_t::size() const {
+    return float32_.size() + int16_.size();
+}
+
+
+size_t
+mpp::risk_table_t::memory() const {
+    return float32_.size() * sizeof(float) + int16_.size() * sizeof(std::int16_t) + scale_.size() * sizeof(double)
+         + (start_.size() + row_.size() + offset_.size()) * sizeof(size_t);
+}
+
+
+void
+mpp::risk_table_t::add(size_t intervention, int start_time, std::vector< std::vector<double> >& risk) const {
+    const size_t k = start_[intervention] + static_cast<size_t>(start_time - 1);
+    size_t t = static_cast<size_t>(start_time - 1);
+    for (size_t row = row_[k]; row < row_[k + 1]; ++row, ++t) {
+        const size_t first = offset_[row];
+        const size_t count = std::min(offset_[row + 1] - first, risk[t].size());
+        double* period_risk = risk[t].data();
+
+        if (precision_ == risk_precision_t::float32) {
+            const float* values = float32_.data() + first;
+            for (size_t s = 0; s < count; ++s) period_risk[s] += values[s];
+        } else {
+            const std::int16_t* values = int16_.data() + first;
+            const double scale = scale_[row];
+            for (size_t s = 0; s < count; ++s) period_risk[s] += scale * values[s];
+        }
+    }
+}
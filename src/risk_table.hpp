@@ -0,0 +1,82 @@
+#ifndef INCLUDE_MPP_RISK_TABLE_HPP_
+#define INCLUDE_MPP_RISK_TABLE_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <problem.hpp>
+
+
+namespace mpp {
+
+    /**
+     * @brief Storage precision of the scenario risks.
+     * @details float64 is the exact evaluation (from the instance data), float32 stores single precision values,
+     * and int16 stores 16-bit integers with a scale per row (the scenarios of an intervention, start time and
+     * period), so that the largest value of the row is represented exactly up to 1/32767 of it.
+     */
+    enum class risk_precision_t { float64, float32, int16 };
+
+    /**
+     * @brief Parse a risk precision from its name ("float64", "float32" or "int16").
+     * @throws std::invalid_argument If the name is unknown.
+     */
+    risk_precision_t parse_risk_precision(const std::string& name);
+
+
+    /**
+     * @brief Scenario risks of a problem instance in reduced precision, for the fast evaluation of solutions.
+     * @details The risks are stored in compressed sparse row form: for each intervention and start time, a row
+     * of scenario risks for each period it covers, in order. A row of floats takes half the memory (and the
+     * bandwidth) of doubles, and a row of 16-bit integers a quarter. Evaluations with the table (see
+     * problem_t::evaluate) are approximate in their objective only, as the constraints do not depend on the risks.
+     * The table is read-only and can be used by concurrent threads.
+     */
+    class risk_table_t {
+        public:
+
+        /**
+         * @brief Build the table from the instance data.
+         * @param problem The maintenance planning problem instance.
+         * @param precision Storage precision (float32 or int16).
+         * @throws std::invalid_argument If the precision is float64 (the exact evaluation does not use a table).
+         */
+        risk_table_t(const problem_t& problem, risk_precision_t precision);
+
+        /**
+         * @brief Storage precision of the table.
+         */
+        risk_precision_t precision() const;
+
+        /**
+         * @brief Number of scenario risks stored.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Memory used by the table in bytes (the values, their scales and the row offsets).
+         */
+        size_t memory() const;
+
+        /**
+         * @brief Add the scenario risks of an intervention to the risk of each period and scenario.
+         * @param intervention Index of the intervention.
+         * @param start_time Start time (1-based) of the intervention.
+         * @param risk Risk of each period (0-based) and scenario.
+         */
+        void add(size_t intervention, int start_time, std::vector< std::vector<double> >& risk) const;
+
+        private:
+        risk_precision_t precision_;
+        std::vector<size_t> start_;                 // First (intervention, start time) of each intervention in row_
+        std::vector<size_t> row_;                   // First row of each (intervention, start time), by period
+        std::vector<size_t> offset_;                // First value of each row
+        std::vector<double> scale_;                 // Scale of each row (int16)
+        std::vector<float> float32_;
+        std::vector<std::int16_t> int16_;
+    };
+
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_RISK_TABLE_HPP_
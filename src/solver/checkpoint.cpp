@@ -0,0 +1,268 @@
+#include <solver/checkpoint.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+
+namespace {
+
+    // Header of the checkpoint files: magic number and version of the format
+    // (the values are written in the byte order of the machine)
+    constexpr char MAGIC[8] = {'M', 'P', 'P', 'C', 'K', 'P', 'T', '\0'};
+    constexpr std::uint32_t VERSION = 1;
+
+    template <typename T>
+    void write_value(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void read_value(std::istream& in, T& value) {
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        if (!in) throw std::runtime_error("Unexpected end of the checkpoint file.");
+    }
+
+    void write_ints(std::ostream& out, const std::vector<int>& values) {
+        write_value<std::uint64_t>(out, values.size());
+        out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int));
+    }
+
+    void read_ints(std::istream& in, std::vector<int>& values) {
+        std::uint64_t size = 0;
+        read_value(in, size);
+        values.resize(size);
+        in.read(reinterpret_cast<char*>(values.data()), size * sizeof(int));
+        if (!in) throw std::runtime_error("Unexpected end of the checkpoint file.");
+    }
+
+    void write_fitness(std::ostream& out, const mpp::solver::fitness_t& fitness) {
+        const auto& [violations, resource_sum, objective] = fitness;
+        write_value(out, violations);
+        write_value(out, resource_sum);
+        write_value(out, objective);
+    }
+
+    void read_fitness(std::istream& in, mpp::solver::fitness_t& fitness) {
+        auto& [violations, resource_sum, objective] = fitness;
+        read_value(in, violations);
+        read_value(in, resource_sum);
+        read_value(in, objective);
+    }
+
+} // namespace
+
+
+std::uint64_t
+mpp::solver::checkpoint_fingerprint(const mpp::problem_t& problem, risk_precision_t risk_precision) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto mix_bytes = [&](const void* data, size_t size) {
+        for (size_t k = 0; k < size; ++k) {
+            hash = (hash ^ static_cast<const unsigned char*>(data)[k]) * 1099511628211ULL;
+        }
+    };
+    auto mix = [&](auto value) { mix_bytes(&value, sizeof(value)); };
+
+    const auto& intervention_names = problem.get_intervention_names();
+    for (const auto& name : intervention_names) {
+        mix_bytes(name.data(), name.size());
+        mix(std::uint8_t(0xFF));
+    }
+    mix(problem.get_T());
+
+    // Start times, durations, workloads and mean risks of each intervention
+    for (size_t i = 0; i < intervention_names.size(); ++i) {
+        mix(problem.get_tmax(i));
+        for (int start_time = 1; start_time <= problem.get_tmax(i); ++start_time) {
+            mix(problem.get_delta(i, start_time));
+            mix(problem.get_mean_risk(i, start_time));
+            for (const auto& workload : problem.get_workload(i, start_time)) {
+                mix(workload.resource);
+                mix(workload.period);
+                mix(workload.amount);
+            }
+        }
+        const auto& allowed_starts = problem.get_allowed_starts(i);
+        mix(allowed_starts.size());
+        mix_bytes(allowed_starts.data(), allowed_starts.size() * sizeof(int));
+    }
+
+    // Resource bounds and exclusions
+    for (size_t r = 0; r < problem.get_resource_names().size(); ++r) {
+        mix_bytes(problem.get_resource_lower_bound(r).data(), problem.get_resource_lower_bound(r).size() * sizeof(double));
+        mix_bytes(problem.get_resource_upper_bound(r).data(), problem.get_resource_upper_bound(r).size() * sizeof(double));
+    }
+    for (const auto& exclusion : problem.get_exclusions()) {
+        mix(exclusion.intervention_1);
+        mix(exclusion.intervention_2);
+        mix(exclusion.season.size());
+        mix_bytes(exclusion.season.data(), exclusion.season.size() * sizeof(int));
+    }
+
+    mix(static_cast<std::uint8_t>(risk_precision));
+    return hash;
+}
+
+
+void
+mpp::solver::save_checkpoint(const checkpoint_t& checkpoint, const std::string& filename) {
+    const std::string temporary_file = filename + ".tmp";
+    {
+        std::ofstream out(temporary_file, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Error opening checkpoint file " + temporary_file + " for writing.");
+        }
+
+        out.write(MAGIC, sizeof(MAGIC));
+        write_value(out, VERSION);
+        write_value(out, checkpoint.fingerprint);
+        write_value(out, checkpoint.generation);
+        write_value(out, checkpoint.stall_generations);
+        write_value(out, checkpoint.evaluations);
+        write_value(out, checkpoint.elapsed);
+
+        // Pool of solutions
+        write_value<std::uint64_t>(out, checkpoint.pool_solutions.size());
+        for (size_t i = 0; i < checkpoint.pool_solutions.size(); ++i) {
+            write_ints(out, checkpoint.pool_solutions[i]);
+            write_fitness(out, checkpoint.pool_fitness[i]);
+        }
+        write_value<std::uint64_t>(out, checkpoint.idx_best);
+
+        // Random number generators (in the text format of the standard library, which is portable)
+        write_value<std::uint64_t>(out, checkpoint.rng.size());
+        for (const auto& rng : checkpoint.rng) {
+            std::ostringstream state;
+            state << rng;
+            const std::string text = state.str();
+            write_value<std::uint64_t>(out, text.size());
+            out.write(text.data(), text.size());
+        }
+
+        // Incumbent
+        write_ints(out, checkpoint.incumbent);
+        write_fitness(out, checkpoint.incumbent_fitness);
+
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Error writing checkpoint file " + temporary_file + ".");
+        }
+    }
+
+    if (std::rename(temporary_file.c_str(), filename.c_str()) != 0) {
+        throw std::runtime_error("Error renaming checkpoint file " + temporary_file + " to " + filename + ".");
+    }
+}
+
+
+mpp::solver::checkpoint_t
+mpp::solver::load_checkpoint(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Error opening checkpoint file " + filename + " for reading.");
+    }
+
+    char magic[sizeof(MAGIC)];
+    std::uint32_t version = 0;
+    in.read(magic, sizeof(magic));
+    if (!in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("File " + filename + " is not a checkpoint file.");
+    }
+    read_value(in, version);
+    if (version != VERSION) {
+        throw std::runtime_error("Unsupported version of the checkpoint file " + filename + ".");
+    }
+
+    checkpoint_t checkpoint;
+    read_value(in, checkpoint.fingerprint);
+    read_value(in, checkpoint.generation);
+    read_value(in, checkpoint.stall_generations);
+    read_value(in, checkpoint.evaluations);
+    read_value(in, checkpoint.elapsed);
+
+    // Pool of solutions
+    std::uint64_t pool_size = 0;
+    read_value(in, pool_size);
+    checkpoint.pool_solutions.resize(pool_size);
+    checkpoint.pool_fitness.resize(pool_size);
+    for (size_t i = 0; i < pool_size; ++i) {
+        read_ints(in, checkpoint.pool_solutions[i]);
+        read_fitness(in, checkpoint.pool_fitness[i]);
+    }
+    std::uint64_t idx_best = 0;
+    read_value(in, idx_best);
+    checkpoint.idx_best = idx_best;
+
+    // Random number generators
+    std::uint64_t rng_count = 0;
+    read_value(in, rng_count);
+    checkpoint.rng.resize(rng_count);
+    for (auto& rng : checkpoint.rng) {
+        std::uint64_t size = 0;
+        read_value(in, size);
+        std::string text(size, '\0');
+        in.read(&text[0], size);
+        std::istringstream state(text);
+        state >> rng;
+        if (!in || !state) throw std::runtime_error("Invalid random number generator state in the checkpoint file.");
+    }
+
+    // Incumbent
+    read_ints(in, checkpoint.incumbent);
+    read_fitness(in, checkpoint.incumbent_fitness);
+
+    if (checkpoint.idx_best >= pool_size || checkpoint.rng.size() != pool_size) {
+        throw std::runtime_error("Inconsistent checkpoint file " + filename + ".");
+    }
+
+    return checkpoint;
+}
+
+
+mpp::solver::checkpoint_writer_t::checkpoint_writer_t(const std::string& filename)
+: filename_(filename), thread_(&checkpoint_writer_t::run, this) { }
+
+
+mpp::solver::checkpoint_writer_t::~checkpoint_writer_t() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stop_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+}
+
+
+void
+mpp::solver::checkpoint_writer_t::submit(checkpoint_t checkpoint) {
+    auto snapshot = std::make_unique<checkpoint_t>(std::move(checkpoint));
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        pending_ = std::move(snapshot);
+    }
+    cv_.notify_one();
+}
+
+
+void
+mpp::solver::checkpoint_writer_t::run() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (true) {
+        cv_.wait(lock, [this]() { return stop_ || pending_ != nullptr; });
+        if (pending_ == nullptr) return;
+
+        // Write the latest snapshot without holding the lock, so the solver can hand over the next one
+        std::unique_ptr<checkpoint_t> snapshot = std::move(pending_);
+        lock.unlock();
+        try {
+            save_checkpoint(*snapshot, filename_);
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to write a checkpoint: " << e.what() << std::endl;
+        }
+        snapshot.reset();
+        lock.lock();
+    }
+}
@@ -0,0 +1,121 @@
+#ifndef INCLUDE_MPP_SOLVER_CHECKPOINT_HPP_
+#define INCLUDE_MPP_SOLVER_CHECKPOINT_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <problem.hpp>
+#include <risk_table.hpp>
+#include <solver/incumbent.hpp>
+
+
+namespace mpp {
+    namespace solver {
+
+        /**
+         * @brief State of a DE run, from which the run can be resumed.
+         * @details Solutions are vectors of start times indexed in the order of
+         * problem_t::get_intervention_names(). The fingerprint identifies the compiled instance and the
+         * precision of its risks, so a checkpoint is not resumed on another (or an edited) instance.
+         * @param fingerprint Fingerprint of the instance (see checkpoint_fingerprint).
+         * @param generation Number of generations completed.
+         * @param stall_generations Number of generations without improvement of the incumbent.
+         * @param evaluations Number of solutions evaluated.
+         * @param elapsed Elapsed time (in seconds) of the run, including previous resumed runs.
+         * @param pool_solutions Solutions in the pool.
+         * @param pool_fitness Fitness of the solutions in the pool.
+         * @param idx_best Index of the best solution in the pool.
+         * @param rng Random number generator of each offspring slot.
+         * @param incumbent Best solution found so far (it may be outside the pool after an LNS run).
+         * @param incumbent_fitness Fitness of the incumbent solution.
+         */
+        struct checkpoint_t {
+            std::uint64_t fingerprint = 0;
+            long long int generation = 0;
+            long long int stall_generations = 0;
+            long long int evaluations = 0;
+            double elapsed = 0.0;
+            std::vector< std::vector<int> > pool_solutions;
+            std::vector<fitness_t> pool_fitness;
+            size_t idx_best = 0;
+            std::vector<std::mt19937> rng;
+            std::vector<int> incumbent;
+            fitness_t incumbent_fitness;
+        };
+
+
+        /**
+         * @brief Fingerprint of an instance, stored in its checkpoints.
+         * @param problem The problem instance.
+         * @param risk_precision Precision of the risks used to rank the pool (see risk_table_t).
+         * @return A hash (FNV-1a) of the compiled instance data: the names of the interventions, the horizon, the
+         * start time limits, durations and allowed start times (so the presolve settings must match), the workloads,
+         * the mean risks, the resource bounds and the exclusions, and of the risk precision.
+         */
+        std::uint64_t checkpoint_fingerprint(const problem_t& problem, risk_precision_t risk_precision = risk_precision_t::float64);
+
+
+        /**
+         * @brief Save a checkpoint to a binary file.
+         * @details The checkpoint is written to a temporary file which is then renamed, so the file is
+         * never left half-written (e.g., if the process is killed while saving it).
+         * @param checkpoint The checkpoint.
+         * @param filename Path to the file.
+         */
+        void save_checkpoint(const checkpoint_t& checkpoint, const std::string& filename);
+
+
+        /**
+         * @brief Load a checkpoint from a binary file written by save_checkpoint.
+         * @param filename Path to the file.
+         * @return The checkpoint.
+         */
+        checkpoint_t load_checkpoint(const std::string& filename);
+
+
+        /**
+         * @brief Writes checkpoints to a file in a background thread.
+         * @details The solver takes a snapshot of its state and hands it over; serializing and writing it
+         * happen in the background, so the solver is not stalled by the disk. If a snapshot is handed over
+         * while the previous one is still being written, only the latest one is kept. Pending snapshots are
+         * written before the writer is destroyed.
+         */
+        class checkpoint_writer_t {
+            public:
+
+            /**
+             * @brief Constructor.
+             * @param filename Path to the checkpoint file (overwritten by each checkpoint).
+             */
+            explicit checkpoint_writer_t(const std::string& filename);
+            ~checkpoint_writer_t();
+
+            checkpoint_writer_t(const checkpoint_writer_t&) = delete;
+            checkpoint_writer_t& operator=(const checkpoint_writer_t&) = delete;
+
+            /**
+             * @brief Hand over a snapshot to be written.
+             */
+            void submit(checkpoint_t checkpoint);
+
+            private:
+            void run();
+
+            std::string filename_;
+            std::mutex mtx_;
+            std::condition_variable cv_;
+            std::unique_ptr<checkpoint_t> pending_;
+            bool stop_ = false;
+            std::thread thread_;
+        };
+
+    } // namespace solver
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_SOLVER_CHECKPOINT_HPP_
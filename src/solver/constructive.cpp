@@ -0,0 +1,114 @@
+#include <solver/constructive.hpp>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+
+std::tuple<mpp::solution_t, mpp::objective_t, mpp::risk_metric_t, mpp::constraints_t>
+mpp::solver::constructive(const mpp::problem_t& problem, int passes) {
+
+    constexpr double tolerance = 1e-5;
+
+    // Problem data
+    const auto& intervention_names = problem.get_intervention_names();
+    const size_t n = intervention_names.size();
+    const size_t n_resources = problem.get_resource_names().size();
+    const int T = problem.get_T();
+
+    // Current resource usage and schedule
+    std::vector< std::vector<double> > usage(n_resources, std::vector<double>(T, 0.0));
+    std::vector<int> start_time(n, 0);  // 0 means not scheduled
+
+    // Violation (count, amount) of the bounds of a resource at a period for a given usage
+    auto violation = [&](int r, int t, double u) -> std::pair<double, double> {
+        const double ub = problem.get_resource_upper_bound(r)[t];
+        const double lb = problem.get_resource_lower_bound(r)[t];
+        if (u > ub + tolerance) return { 1.0, u - ub };
+        if (u < lb - tolerance) return { 1.0, lb - u };
+        return { 0.0, 0.0 };
+    };
+
+    // Cost of scheduling intervention i at start time s, given the interventions already scheduled.
+    // It is compared lexicographically, as the DE fitness: (violations, violation amount, mean risk)
+    auto cost = [&](size_t i, int s) {
+        double count = 0.0;
+        double amount = 0.0;
+
+        for (const auto& w : problem.get_workload(i, s)) {
+            const double u = usage[w.resource][w.period];
+            auto [count_before, amount_before] = violation(w.resource, w.period, u);
+            auto [count_after, amount_after] = violation(w.resource, w.period, u + w.amount);
+            count += count_after - count_before;
+            amount += amount_after - amount_before;
+        }
+
+        count += problem.get_exclusion_violations(i, s, start_time);
+
+        return std::make_tuple(count, amount, problem.get_mean_risk(i, s));
+    };
+
+    auto apply = [&](size_t i, int s, double sign) {
+        for (const auto& w : problem.get_workload(i, s)) {
+            usage[w.resource][w.period] += sign * w.amount;
+        }
+    };
+
+    // Schedule intervention i at its best start time
+    auto insert = [&](size_t i) {
+        const auto& allowed_starts = problem.get_allowed_starts(i);
+        int best_start = allowed_starts.front();
+        auto best_cost = cost(i, best_start);
+        for (int s : allowed_starts) {
+            auto c = cost(i, s);
+            if (c < best_cost) {
+                best_cost = c;
+                best_start = s;
+            }
+        }
+        start_time[i] = best_start;
+        apply(i, best_start, 1.0);
+    };
+
+    // Schedule the least flexible and heaviest interventions first
+    std::vector<double> average_workload(n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        for (int s : problem.get_allowed_starts(i)) {
+            for (const auto& w : problem.get_workload(i, s)) {
+                average_workload[i] += w.amount;
+            }
+        }
+        average_workload[i] /= problem.get_allowed_starts(i).size();
+    }
+
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const size_t flexibility_a = problem.get_allowed_starts(a).size();
+        const size_t flexibility_b = problem.get_allowed_starts(b).size();
+        if (flexibility_a != flexibility_b) return flexibility_a < flexibility_b;
+        return average_workload[a] > average_workload[b];
+    });
+
+    for (size_t i : order) {
+        insert(i);
+    }
+
+    // Improve the schedule by re-inserting each intervention at its best start time
+    for (int pass = 0; pass < passes; ++pass) {
+        for (size_t i : order) {
+            apply(i, start_time[i], -1.0);
+            start_time[i] = 0;
+            insert(i);
+        }
+    }
+
+    // Decode and evaluate the solution
+    mpp::solution_t solution;
+    for (size_t i = 0; i < n; ++i) {
+        solution[intervention_names[i]] = start_time[i];
+    }
+
+    auto [objective, risk_metric, constraints] = problem.evaluate(solution);
+    return { solution, objective, risk_metric, constraints };
+}
@@ -0,0 +1,29 @@
+#ifndef INCLUDE_MPP_SOLVER_CONSTRUCTIVE_HPP_
+#define INCLUDE_MPP_SOLVER_CONSTRUCTIVE_HPP_
+
+#include <tuple>
+#include <problem.hpp>
+
+
+namespace mpp {
+    namespace solver {
+
+        /**
+         * @brief Greedy resource-aware constructive heuristic for the maintenance planning problem.
+         * @details Interventions are scheduled one at a time (the least flexible and heaviest first), each
+         * one at the start time that least increases resource excess and exclusion conflicts with the
+         * interventions already scheduled, while filling resource deficits and, among equally good
+         * options, with the lowest mean risk. The schedule is then improved by a few passes that
+         * re-insert each intervention at its best start time. It does not require a MIP solver.
+         * @param problem The maintenance planning problem instance.
+         * @param passes Number of re-insertion passes after the greedy construction.
+         * @return A tuple containing the solution, objective value, risk metric, and constraints.
+         */
+        std::tuple<solution_t, objective_t, risk_metric_t, constraints_t>
+        constructive(const problem_t& problem, int passes = 2);
+
+    } // namespace solver
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_SOLVER_CONSTRUCTIVE_HPP_
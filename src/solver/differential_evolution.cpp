@@ -1,6 +1,16 @@
 #include <solver/differential_evolution.hpp>
 #include <solver/relaxed_mip.hpp>
+#include <solver/constructive.hpp>
+#include <solver/incumbent.hpp>
+#include <solver/lns.hpp>
+#include <solver/checkpoint.hpp>
+#include <solver/lower_bound.hpp>
+#include <solver/repair.hpp>
+#include <risk_table.hpp>
 #include <utils.hpp>
+#include <stats.hpp>
+#include <trace.hpp>
+#include <thread_pool.hpp>
 #include <tuple>
 #include <vector>
 #include <limits>
@@ -9,8 +19,14 @@
 #include <utility>
 #include <iostream>
 #include <algorithm>
-#include <execution>
+#include <numeric>
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
 #include <cxxtimer.hpp>
 
 
@@ -23,55 +39,120 @@ mpp::solver::differential_evolution(const mpp::problem_t& problem, const differe
     const double scaling_factor = settings.scaling_factor;      // Scaling factor for mutation
     const double crossover_rho = settings.crossover_rho;        // Rho parameter for crossover recombination
     const long long int timelimit = settings.timelimit;         // Limits the runtime in seconds
-    const long long int mip_timelimit = settings.mip_timelimit; // Limits the runtime of the MIP solver in seconds
+    const long long int max_generations = settings.max_generations; // Limits the number of generations
     const int threads = settings.threads;                       // Number of threads for parallel processing
     const unsigned int seed = settings.seed;                    // Random seed for generating a random solution
     const bool verbose = settings.verbose;                      // Enable verbose output
+#ifdef MPP_WITH_GUROBI
+    const long long int mip_timelimit = settings.mip_timelimit; // Limits the runtime of the MIP solver in seconds
+    const size_t mip_starts = settings.mip_starts;              // Number of solutions from the pool used as MIP starts
+    const long long int lns_stall = settings.lns_stall;         // Generations without improvement before running the LNS
+#endif
 
     // Start the timer
     cxxtimer::Timer timer(true);
 
+    // State of the run to resume, if any (its elapsed time counts against the time limit)
+    std::unique_ptr<mpp::solver::checkpoint_t> resumed;
+    if (!settings.resume.empty()) {
+        resumed = std::make_unique<mpp::solver::checkpoint_t>(mpp::solver::load_checkpoint(settings.resume));
+        if (resumed->fingerprint != mpp::solver::checkpoint_fingerprint(problem, settings.risk_precision)) {
+            throw std::invalid_argument("Checkpoint " + settings.resume + " was written for another instance or with other settings.");
+        }
+        if (resumed->pool_solutions.size() != pool_size) {
+            throw std::invalid_argument("Checkpoint " + settings.resume + " was written with another pool size.");
+        }
+
+        // Every restored start time must be allowed (they index the compiled data of the instance)
+        auto valid = [&](const std::vector<int>& solution) {
+            if (solution.size() != problem.get_intervention_names().size()) return false;
+            for (size_t i = 0; i < solution.size(); ++i) {
+                const auto& allowed_starts = problem.get_allowed_starts(i);
+                if (!std::binary_search(allowed_starts.begin(), allowed_starts.end(), solution[i])) return false;
+            }
+            return true;
+        };
+        for (const auto& solution : resumed->pool_solutions) {
+            if (!valid(solution)) {
+                throw std::invalid_argument("Checkpoint " + settings.resume + " was written for another instance.");
+            }
+        }
+        if (!resumed->incumbent.empty() && !valid(resumed->incumbent)) {
+            throw std::invalid_argument("Checkpoint " + settings.resume + " was written for another instance.");
+        }
+    }
+    const double previous_elapsed = resumed ? resumed->elapsed : 0.0;
+    auto elapsed = [&]() { return previous_elapsed + timer.count<cxxtimer::ms>() / 1000.0; };
+
+    // The run stops at the earliest of the deadline and the time limit, or when it is cancelled. The time limit
+    // counts the elapsed time of the resumed runs: once it is used up, the resumed incumbent is returned at once
+    const bool unlimited = (timelimit < 0 || timelimit == std::numeric_limits<long long int>::max());
+    const mpp::deadline_t deadline = settings.deadline.earliest(
+        unlimited ? mpp::deadline_t() : mpp::deadline_t(std::max(0.0, static_cast<double>(timelimit) - previous_elapsed)));
+    auto stop_requested = [&]() { return deadline.expired() || settings.cancellation.cancelled(); };
+
+    // Best lower bound on the objective of the feasible solutions (improved by the Relaxed MIP bound)
+    double lower_bound = mpp::solver::separable_lower_bound(problem);
+
     // Initialize the Random number generator (Mersenne Twister 19937 generator)
     std::mt19937 rng(seed);
 
     // Problem data
-    const auto& data = problem.get_data();
+    // The search is restricted to the allowed start times of each intervention (see presolve)
     const auto& interventions = problem.get_intervention_names();
     const size_t n_var = interventions.size();
     std::vector<int> lb(interventions.size(), 1);
     std::vector<int> ub(interventions.size(), 1);
+    std::vector<bool> contiguous(interventions.size(), true);
 
     for (size_t i = 0; i < interventions.size(); ++i) {
-        const auto& intervention_data = data[mpp::params::INTERVENTIONS][interventions[i]];
-        ub[i] = intervention_data[mpp::params::INTERVENTION_TMAX].template get<int>();
+        const auto& allowed_starts = problem.get_allowed_starts(i);
+        lb[i] = allowed_starts.front();
+        ub[i] = allowed_starts.back();
+        contiguous[i] = (allowed_starts.size() == static_cast<size_t>(ub[i] - lb[i] + 1));
     }
 
     // Define some types for better readability 
     using solution_t = std::vector<int>;
-    using solution_evaluation_t = std::tuple<mpp::objective_t, mpp::risk_metric_t, mpp::constraints_t>;
-    constexpr double INF = std::numeric_limits<double>::max();
-
-    // Compute the fitness from solution evaluation
-    // The fitness is a tuple of (exclusions + resource_count, resource_sum, objective)
-    auto make_fitness = [](const solution_evaluation_t& eval) {
-        const auto& [objective, risk_metric, constraints] = eval;
-        const auto& [exclusions, resource_count, resource_sum] = constraints;
-        return std::make_tuple(exclusions + resource_count, resource_sum, objective);
-    };
-
-    // Define the fitness type for better readability
-    using fitness_t = std::invoke_result_t<decltype(make_fitness), solution_evaluation_t>;
+    using mpp::solver::fitness_t;
+    using mpp::solver::make_fitness;
     
     // Create the probability distribution for exponential crossover operator
     std::vector<double> crossover_weights(n_var);       
     for (size_t i = 1; i <= n_var; ++i) { 
         crossover_weights[i-1] = std::pow(crossover_rho, i-1) - std::pow(crossover_rho, i);
     }
-    std::discrete_distribution<int> crossorver_dist(crossover_weights.begin(), crossover_weights.end());
+    // Sampling uses the cumulative weights (read-only), so it can be shared by concurrent threads
+    std::vector<double> crossover_cdf(n_var);
+    std::partial_sum(crossover_weights.begin(), crossover_weights.end(), crossover_cdf.begin());
+    auto crossover_dist = [&](std::mt19937& rng) {
+        double u = std::uniform_real_distribution<double>(0.0, crossover_cdf.back())(rng);
+        size_t k = std::upper_bound(crossover_cdf.begin(), crossover_cdf.end(), u) - crossover_cdf.begin();
+        return std::min(k, n_var - 1);
+    };
+
+    // Thread pool for parallel processing: the shared pool, if given, or a pool owned by this run.
+    // The calling thread also works on the parallel loops, so a run with t threads needs t-1 workers.
+    std::unique_ptr<mpp::thread_pool_t> own_thread_pool;
+    mpp::thread_pool_t* thread_pool = settings.thread_pool;
+    if (thread_pool == nullptr && threads > 1) {
+        own_thread_pool = std::make_unique<mpp::thread_pool_t>(threads - 1);
+        thread_pool = own_thread_pool.get();
+    }
 
-    // Auxiliary vector of indices for parallel processing
-    std::vector<int> indices(pool_size);
-    std::iota(indices.begin(), indices.end(), 0); // Fill with 0, 1, ..., pool_size-1
+    // Scenario risks in reduced precision (optional): the pool is ranked with approximate objectives, and the
+    // best solutions are re-scored exactly before they are offered to the incumbent
+    std::unique_ptr<const mpp::risk_table_t> risk_table;
+    if (settings.risk_precision != mpp::risk_precision_t::float64) {
+        risk_table = std::make_unique<const mpp::risk_table_t>(problem, settings.risk_precision);
+        if (verbose) {
+            std::cout << "Risk table: " << risk_table->size() << " scenario risks, " << risk_table->memory() / (1024.0 * 1024.0)
+                      << " MiB (" << risk_table->size() * sizeof(double) / (1024.0 * 1024.0) << " MiB in double precision)" << std::endl;
+        }
+    }
+    auto evaluate = [&](const solution_t& solution) {
+        return risk_table ? problem.evaluate(solution, *risk_table) : problem.evaluate(solution, interventions);
+    };
 
     // Pool of solutions
     std::vector<solution_t> pool_solutions; // Pool of solutions
@@ -83,42 +164,232 @@ mpp::solver::differential_evolution(const mpp::problem_t& problem, const differe
     pool_solutions.reserve(pool_size);
     pool_fitness.reserve(pool_size);
 
-    // Generate random solutions and evaluate them
-    for (size_t i = 0; i < pool_size; ++i) {
-
-        pool_solutions.emplace_back(n_var);
+    // Initial solutions, snapped to the allowed start times
+    std::vector<solution_t> initial_solutions;
+    for (const auto& initial_solution : settings.initial_solutions) {
+        initial_solutions.emplace_back(n_var);
         for (size_t j = 0; j < n_var; ++j) {
-            pool_solutions[i][j] = rng() % (ub[j] - lb[j] + 1) + lb[j];
+            const auto& allowed_starts = problem.get_allowed_starts(j);
+            const auto& it = initial_solution.find(interventions[j]);
+            initial_solutions.back()[j] = (it != initial_solution.end())
+                ? mpp::utils::nearest_allowed(it->second, allowed_starts)
+                : allowed_starts[rng() % allowed_starts.size()];
+        }
+    }
+
+    // Generate the initial solutions, their mutated copies or, if no initial solution is given,
+    // random solutions and evaluate them (or restore the pool of the resumed run)
+    std::uniform_real_distribution<double> unif(0.0, 1.0);
+    if (resumed) {
+
+        // The fitness of the pool is recomputed rather than trusted (pool_size evaluations)
+        pool_solutions = resumed->pool_solutions;
+        for (const auto& solution : pool_solutions) {
+            pool_fitness.emplace_back(make_fitness(evaluate(solution)));
+        }
+        if (!resumed->incumbent.empty()) {
+            resumed->incumbent_fitness = make_fitness(problem.evaluate(resumed->incumbent, interventions));
         }
+        idx_best = resumed->idx_best;
+        for (size_t i = 0; i < pool_size; ++i) {
+            if (pool_fitness[i] < pool_fitness[idx_best]) idx_best = i;
+        }
+        idx_worst = std::distance(pool_fitness.begin(), std::max_element(pool_fitness.begin(), pool_fitness.end()));
+    } else {
+        for (size_t i = 0; i < pool_size; ++i) {
+
+            pool_solutions.emplace_back(n_var);
+            if (i < initial_solutions.size()) {
+                pool_solutions[i] = initial_solutions[i];
+            } else if (!initial_solutions.empty()) {
+                pool_solutions[i] = initial_solutions[i % initial_solutions.size()];
+                for (size_t j = 0; j < n_var; ++j) {
+                    if (unif(rng) < settings.initial_mutation) {
+                        const auto& allowed_starts = problem.get_allowed_starts(j);
+                        pool_solutions[i][j] = allowed_starts[rng() % allowed_starts.size()];
+                    }
+                }
+            } else {
+                for (size_t j = 0; j < n_var; ++j) {
+                    const auto& allowed_starts = problem.get_allowed_starts(j);
+                    pool_solutions[i][j] = allowed_starts[rng() % allowed_starts.size()];
+                }
+            }
 
-        pool_fitness.emplace_back(make_fitness(problem.evaluate(pool_solutions[i], interventions)));
+            pool_fitness.emplace_back(make_fitness(evaluate(pool_solutions[i])));
 
-        // Track the best and worst solutions
-        if (pool_fitness[i] < pool_fitness[idx_best]) idx_best = i;
-        if (pool_fitness[i] > pool_fitness[idx_worst]) idx_worst = i;
+            // Track the best and worst solutions
+            if (pool_fitness[i] < pool_fitness[idx_best]) idx_best = i;
+            if (pool_fitness[i] > pool_fitness[idx_worst]) idx_worst = i;
+        }
     }
 
-    // Replace the worst solution with a solution from the Relaxed MIP
-    if (verbose) std::cout << "Solving the Relaxed MIP..." << std::endl;
-    try {
+    // Number of solutions evaluated (updated concurrently by the offspring slots)
+    std::atomic<long long int> evaluations(resumed ? resumed->evaluations : static_cast<long long int>(pool_size));
+
+    // Incumbent solution, shared with the LNS
+    mpp::solver::incumbent_t incumbent;
+    if (resumed) incumbent.update(resumed->incumbent, resumed->incumbent_fitness);
+
+    // Offer the best solution of the pool to the incumbent (re-scored exactly when the pool is ranked with the
+    // risk table, only if its approximate fitness improved since it was last offered)
+    fitness_t offered_fitness;
+    bool offered = false;
+    auto update_incumbent = [&]() {
+        if (!risk_table) return incumbent.update(pool_solutions[idx_best], pool_fitness[idx_best]);
+        if (offered && !(pool_fitness[idx_best] < offered_fitness)) return false;
+        offered_fitness = pool_fitness[idx_best];
+        offered = true;
+        mpp::stats::count(mpp::stats::counter_t::exact_rescores);
+        return incumbent.update(pool_solutions[idx_best], make_fitness(problem.evaluate(pool_solutions[idx_best], interventions)));
+    };
+    update_incumbent();
+
+    // Report the incumbent to the caller, if it improved since the last report
+    fitness_t reported_fitness;
+    bool reported = false;
+    auto report_incumbent = [&](const char* source) {
+        if (!settings.on_incumbent || (reported && !(incumbent.fitness() < reported_fitness))) return;
+        auto [incumbent_solution, incumbent_fitness] = incumbent.get();
+        mpp::solver::incumbent_event_t event;
+        event.time = elapsed();
+        event.evaluations = evaluations.load();
+        event.lower_bound = lower_bound;
+        event.source = source;
+        const auto [objective, risk_metric, constraints] = problem.evaluate(incumbent_solution);
+        std::tie(event.mean_risk, event.expected_excess) = risk_metric;
+        std::tie(event.exclusions, event.resource_count, std::ignore) = constraints;
+        settings.on_incumbent(incumbent_solution, incumbent_fitness, event);
+        reported_fitness = incumbent_fitness;
+        reported = true;
+    };
 
-        // Solve the MIP model
-        auto [hot_solution, hot_objective, hot_risk, hot_constraints] = mpp::solver::relaxed_mip(problem, mip_timelimit, threads, verbose);
-        pool_fitness[idx_worst] = make_fitness(std::make_tuple(hot_objective, hot_risk, hot_constraints));
-        for (size_t j = 0; j < n_var; ++j) {
-            pool_solutions[idx_worst][j] = hot_solution[interventions[j]];
+    report_incumbent(resumed ? "checkpoint" : (initial_solutions.empty() ? "random" : "initial"));
+
+    // The run also stops once the gap between a feasible incumbent and the lower bound is closed
+    // (up to the tolerance and the rounding errors of the bound)
+    auto gap_closed = [&]() {
+        if (settings.gap < 0.0) return false;
+        const auto [violations, resource_sum, objective] = incumbent.fitness();
+        return violations == 0.0 && mpp::solver::relative_gap(objective, lower_bound) <= settings.gap + 1e-9;
+    };
+
+    // Replace the worst solution with a seed solution from the Relaxed MIP or, if it is not
+    // available (built without Gurobi, no license or no solution found), from the constructive heuristic
+    // (a resumed pool already contains it)
+    if (!resumed) {
+        std::tuple<mpp::solution_t, mpp::objective_t, mpp::risk_metric_t, mpp::constraints_t> seed_solution;
+        bool seeded = false;
+        auto seed_start = std::chrono::steady_clock::now();
+
+#ifdef MPP_WITH_GUROBI
+        // Relaxed MIP seed (skipped if the time is up, e.g., when loading or presolving used the whole budget)
+        double mip_bound = -std::numeric_limits<double>::infinity();  // Bound on the mean risk (set even if the MIP fails)
+        if (!stop_requested() && deadline.remaining() > 0.0) {
+            try {
+                if (verbose) std::cout << "Solving the Relaxed MIP..." << std::endl;
+
+                // Warm-start the MIP with the initial solutions and the best solutions in the pool
+                std::vector<size_t> ranking(pool_size);
+                std::iota(ranking.begin(), ranking.end(), 0);
+                std::sort(ranking.begin(), ranking.end(), [&](size_t a, size_t b) { return pool_fitness[a] < pool_fitness[b]; });
+
+                std::vector<solution_t> starts(initial_solutions);
+                for (size_t k = 0; k < pool_size && starts.size() < mip_starts; ++k) {
+                    starts.push_back(pool_solutions[ranking[k]]);
+                }
+
+                // Solve the MIP model
+                double mip_remaining = deadline.remaining();
+                if (mip_timelimit >= 0) mip_remaining = std::min(mip_remaining, static_cast<double>(mip_timelimit));
+                seed_solution = mpp::solver::relaxed_mip(problem, std::isinf(mip_remaining) ? -1.0 : mip_remaining, threads, verbose, starts, settings.cancellation, &mip_bound);
+                seeded = true;
+
+                if (verbose) std::cout << "Done!"<< std::endl;
+            } catch (...) {
+                if (verbose) {
+                    std::cout << "Failed to find a solution using the Relaxed MIP." << std::endl;
+                }
+            }
         }
+        lower_bound = std::max(lower_bound, mpp::solver::objective_lower_bound(problem, mip_bound));
+#endif
 
-        // Update the best solution if necessary
-        if (pool_fitness[idx_worst] < pool_fitness[idx_best]) {
+        if (!seeded) {
+            if (verbose) std::cout << "Building a constructive solution..." << std::endl;
+            seed_solution = mpp::solver::constructive(problem);
+            if (verbose) std::cout << "Done!"<< std::endl;
+        }
+
+        mpp::stats::add_time(mpp::stats::phase_t::seed, std::chrono::steady_clock::now() - seed_start);
+        if (mpp::trace::enabled()) mpp::trace::record("seed", seed_start, std::chrono::steady_clock::now());
+
+        {
+            auto& [hot_solution, hot_objective, hot_risk, hot_constraints] = seed_solution;
+            for (size_t j = 0; j < n_var; ++j) {
+                pool_solutions[idx_worst][j] = hot_solution[interventions[j]];
+            }
+            // The seed is scored exactly: re-score it with the risk table when the pool is ranked with it
+            pool_fitness[idx_worst] = risk_table ? make_fitness(evaluate(pool_solutions[idx_worst]))
+                                                 : make_fitness(std::make_tuple(hot_objective, hot_risk, hot_constraints));
+
+            // Update the best solution if necessary
+            if (pool_fitness[idx_worst] < pool_fitness[idx_best]) {
+                idx_best = idx_worst;
+            }
+        }
+
+        update_incumbent();
+        report_incumbent(seeded ? "mip" : "constructive");
+    }
+    if (verbose) std::cout << "Lower bound: " << lower_bound << std::endl;
+#ifdef MPP_WITH_GUROBI
+    std::unique_ptr<mpp::solver::large_neighborhood_search_t> lns;  // Built on the first stall and reused afterwards
+    bool lns_enabled = (lns_stall > 0);
+#endif
+    long long int stall_iterations = resumed ? resumed->stall_generations : 0;
+
+    // Replace the worst solution in the pool with the incumbent, if it is better than the best one
+    // (after the incumbent is improved by another engine). The incumbent is scored exactly, so it is
+    // re-scored with the risk table when the pool is ranked with it
+    auto share_incumbent = [&]() {
+        auto [incumbent_solution, incumbent_fitness] = incumbent.get();
+        if (risk_table) incumbent_fitness = make_fitness(evaluate(incumbent_solution));
+        if (incumbent_fitness < pool_fitness[idx_best]) {
+            idx_worst = std::distance(pool_fitness.begin(), std::max_element(pool_fitness.begin(), pool_fitness.end()));
+            pool_solutions[idx_worst] = incumbent_solution;
+            pool_fitness[idx_worst] = incumbent_fitness;
             idx_best = idx_worst;
         }
+    };
 
-        if (verbose) std::cout << "Done!"<< std::endl;
-    } catch (...) {
-        if (verbose) {
-            std::cout << "Failed to find a solution using the Relaxed MIP." << std::endl;
-            std::cout << "Continuing with the current pool of solutions." << std::endl;
+    // Lagrangian relaxation: a bound on the mean risk, and feasible solutions repaired from the relaxed schedules
+    std::unique_ptr<mpp::solver::lagrangian_relaxation_t> lagrangian;
+    if (settings.lagrangian_iterations > 0 && !stop_requested() && deadline.remaining() > 0.0) {
+        if (verbose) std::cout << "Running the Lagrangian relaxation..." << std::endl;
+        mpp::solver::lagrangian_settings_t lagrangian_settings;
+        lagrangian_settings.iterations = settings.lagrangian_iterations;
+        lagrangian_settings.threads = threads;
+        lagrangian_settings.thread_pool = thread_pool;
+        lagrangian_settings.cancellation = settings.cancellation;
+        lagrangian_settings.verbose = verbose;
+        lagrangian = std::make_unique<mpp::solver::lagrangian_relaxation_t>(problem, lagrangian_settings);
+
+        const double lagrangian_remaining = deadline.remaining();
+        lagrangian->run(incumbent, std::isinf(lagrangian_remaining) ? -1.0 : lagrangian_remaining);
+        lower_bound = std::max(lower_bound, mpp::solver::objective_lower_bound(problem, lagrangian->bound()));
+        report_incumbent("lagrangian");
+        share_incumbent();
+        if (verbose) std::cout << "Lower bound: " << lower_bound << std::endl;
+    }
+
+    // Repair of the trial vectors, guided by the Lagrangian reduced costs when they are available
+    std::unique_ptr<mpp::solver::repair_t> repair;
+    mpp::solver::repair_cost_t repair_cost = nullptr;
+    if (settings.repair) {
+        repair = std::make_unique<mpp::solver::repair_t>(problem);
+        if (lagrangian) {
+            repair_cost = [&](size_t intervention, int start_time) { return lagrangian->reduced_cost(intervention, start_time); };
         }
     }
 
@@ -126,16 +397,63 @@ mpp::solver::differential_evolution(const mpp::problem_t& problem, const differe
     std::vector<solution_t> offspring_solutions(pool_solutions);
     std::vector<fitness_t> offspring_fitness(pool_fitness);
 
+    // Random number generator of each offspring slot, so that parallel runs are
+    // thread-safe and reproducible regardless of the number of threads
+    std::vector<std::mt19937> offspring_rng;
+    offspring_rng.reserve(pool_size);
+    for (size_t i = 0; i < pool_size; ++i) {
+        offspring_rng.emplace_back(rng());
+    }
+    if (resumed) offspring_rng = resumed->rng;
+
+    // Snapshot of the state of the run, written in the background so that the generations are not stalled
+    std::unique_ptr<mpp::solver::checkpoint_writer_t> checkpoint_writer;
+    if (!settings.checkpoint.empty()) {
+        checkpoint_writer = std::make_unique<mpp::solver::checkpoint_writer_t>(settings.checkpoint);
+    }
+    const std::uint64_t fingerprint = mpp::solver::checkpoint_fingerprint(problem, settings.risk_precision);
+    double next_checkpoint = settings.checkpoint_interval;
+
     // Main loop
-    long long int current_iteration = 0;
-    while (timer.count<cxxtimer::s>() < timelimit) {
+    long long int current_iteration = resumed ? resumed->generation : 0;
+
+    auto save_checkpoint = [&]() {
+        mpp::solver::checkpoint_t checkpoint;
+        checkpoint.fingerprint = fingerprint;
+        checkpoint.generation = current_iteration;
+        checkpoint.stall_generations = stall_iterations;
+        checkpoint.evaluations = evaluations.load();
+        checkpoint.elapsed = elapsed();
+        checkpoint.pool_solutions = pool_solutions;
+        checkpoint.pool_fitness = pool_fitness;
+        checkpoint.idx_best = idx_best;
+        checkpoint.rng = offspring_rng;
+        std::tie(checkpoint.incumbent, checkpoint.incumbent_fitness) = incumbent.get();
+        checkpoint_writer->submit(std::move(checkpoint));
+    };
+
+    while (!stop_requested() && !gap_closed() && (max_generations < 0 || current_iteration < max_generations)) {
+        mpp::trace::span_t generation_span("generation");
 
         // Track the best solution in the offspring pool
         size_t idx_best_offspring = 0;  // Index of the best offspring solution
         std::mutex mtx_best_offspring;  // Mutex for thread-safe access when updating the best offspring solution
 
         // Lambda function to generate offspring solutions
-        auto generate_offspring_solution = [&](const int i) {
+        auto generate_offspring_solution = [&](const size_t i) {
+
+            // Keep the parent once the run must stop, so that the generation is cut short
+            if (stop_requested()) {
+                offspring_solutions[i] = pool_solutions[i];
+                offspring_fitness[i] = pool_fitness[i];
+                std::lock_guard<std::mutex> lock(mtx_best_offspring);
+                if (offspring_fitness[i] < offspring_fitness[idx_best_offspring]) idx_best_offspring = i;
+                return;
+            }
+
+            // Random number generator of this offspring slot
+            std::mt19937& rng = offspring_rng[i];
+            auto mutation_start = std::chrono::steady_clock::now();
 
             // Mutation parameters
             size_t idx1, idx2, idx3;
@@ -145,29 +463,60 @@ mpp::solver::differential_evolution(const mpp::problem_t& problem, const differe
 
             // Crossover parameters
             size_t k1 = rng() % n_var;
-            size_t k2 = k1 + crossorver_dist(rng) + 1;
+            size_t k2 = k1 + crossover_dist(rng) + 1;
 
             // Create a trial vector using mutation and crossover
+            bool changed = false;
             for (size_t j = 0; j < n_var; ++j) {
                 if ((k2 < n_var && j >= k1 && j <= k2) || (k2 >= n_var && (j >= k1 || j <= (k2 % n_var)))) {
                     offspring_solutions[i][j] = mpp::utils::bounded_round(pool_solutions[idx1][j] + scaling_factor * (pool_solutions[idx2][j] - pool_solutions[idx3][j]), lb[j], ub[j]);
+                    if (!contiguous[j]) {
+                        offspring_solutions[i][j] = mpp::utils::nearest_allowed(offspring_solutions[i][j], problem.get_allowed_starts(j));
+                    }
+                    changed |= (offspring_solutions[i][j] != pool_solutions[i][j]);
                 } else {
                     offspring_solutions[i][j] = pool_solutions[i][j];
                 }
             }
 
+            // Repair the trial vector (within the work budget)
+            if (repair && changed && repair->repair(offspring_solutions[i], settings.repair_budget, repair_cost, &rng)) {
+                mpp::stats::count(mpp::stats::counter_t::trial_repairs);
+                changed = (offspring_solutions[i] != pool_solutions[i]);
+            }
+
+            auto evaluation_start = std::chrono::steady_clock::now();
+            mpp::stats::add_time(mpp::stats::phase_t::mutation, evaluation_start - mutation_start);
+            mpp::stats::count(mpp::stats::counter_t::trials);
+
             // Evaluate the trial vector and update the offspring pool
-            fitness_t trial_fitness(make_fitness(problem.evaluate(offspring_solutions[i], interventions)));
+            // (a trial vector equal to its parent keeps the fitness of the parent, without evaluating it)
+            fitness_t trial_fitness = pool_fitness[i];
+            if (changed) {
+                trial_fitness = make_fitness(evaluate(offspring_solutions[i]));
+                evaluations.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                mpp::stats::count(mpp::stats::counter_t::evaluation_cache_hits);
+            }
+
+            auto selection_start = std::chrono::steady_clock::now();
+            mpp::stats::add_time(mpp::stats::phase_t::evaluation, selection_start - evaluation_start);
+            mpp::stats::scoped_timer_t selection_timer(mpp::stats::phase_t::selection);
 
             if (trial_fitness < pool_fitness[i]) {
                 offspring_fitness[i] = trial_fitness;
+                mpp::stats::count(mpp::stats::counter_t::trial_improvements);
             } else {
                 offspring_fitness[i] = pool_fitness[i];
                 offspring_solutions[i] = pool_solutions[i];
             }
 
             // Critical section: Update the best solution in the offspring pool
-            std::lock_guard<std::mutex> lock(mtx_best_offspring);
+            std::unique_lock<std::mutex> lock(mtx_best_offspring, std::defer_lock);
+            {
+                mpp::trace::span_t lock_span("best_offspring_lock");
+                lock.lock();
+            }
             if (offspring_fitness[i] < offspring_fitness[idx_best_offspring]) {
                 idx_best_offspring = i;
             }
@@ -178,10 +527,10 @@ mpp::solver::differential_evolution(const mpp::problem_t& problem, const differe
         };
 
         // Create offspring solutions (in parallel, if enabled)
-        if (threads > 1) {
-            std::for_each(std::execution::par, indices.begin(), indices.end(), generate_offspring_solution);
+        if (thread_pool != nullptr && threads > 1) {
+            thread_pool->parallel_for(pool_size, generate_offspring_solution, threads);
         } else {
-            std::for_each(std::execution::seq, indices.begin(), indices.end(), generate_offspring_solution);
+            for (size_t i = 0; i < pool_size; ++i) generate_offspring_solution(i);
         }
 
         // Update the main pool of solutions and fitness values
@@ -193,22 +542,78 @@ mpp::solver::differential_evolution(const mpp::problem_t& problem, const differe
 
         // Increment the iteration counter
         ++current_iteration;
+        mpp::stats::count(mpp::stats::counter_t::generations);
+
+        // Count the generations without improvement of the incumbent
+        if (update_incumbent()) {
+            mpp::stats::count(mpp::stats::counter_t::incumbent_improvements);
+            stall_iterations = 0;
+        } else {
+            ++stall_iterations;
+        }
+        report_incumbent("de");
+
+#ifdef MPP_WITH_GUROBI
+        // Improve the incumbent with the MIP-based LNS when the DE stalls
+        if (lns_enabled && stall_iterations >= lns_stall && !stop_requested() && deadline.remaining() > 0.0) {
+            double lns_timelimit = std::min(settings.lns.timelimit, deadline.remaining());
+
+            try {
+                if (verbose) std::cout << "Running the LNS..." << std::endl;
+                if (!lns) {
+                    mpp::solver::lns_settings_t lns_settings = settings.lns;
+                    lns_settings.verbose = verbose;
+                    lns_settings.cancellation = settings.cancellation;
+                    lns_settings.thread_pool = thread_pool;
+                    lns = std::make_unique<mpp::solver::large_neighborhood_search_t>(problem, lns_settings);
+                }
+                {
+                    mpp::stats::scoped_timer_t lns_timer(mpp::stats::phase_t::lns);
+                    mpp::trace::span_t lns_span("lns");
+                    mpp::stats::count(mpp::stats::counter_t::lns_runs);
+                    lns->run(incumbent, lns_timelimit, seed + static_cast<unsigned int>(current_iteration));
+                }
+                report_incumbent("lns");
+                share_incumbent();
+            } catch (...) {
+                if (verbose) std::cout << "Failed to run the LNS. Disabling it for the rest of the run." << std::endl;
+                lns_enabled = false;
+            }
+
+            stall_iterations = 0;
+        }
+#endif
 
         // Logging, if enabled
         if (verbose) {
             const auto& [violated_constraints, exceeded_resources, objective] = pool_fitness[idx_best];
             std::cout << std::fixed << std::setprecision(7) << current_iteration << " | "
-                      << std::fixed << std::setprecision(5) << timer.count<cxxtimer::s>() << " | "
+                      << std::fixed << std::setprecision(5) << elapsed() << " | "
                       << violated_constraints << " | "
                       << exceeded_resources << " | "
                       << objective << std::endl;
         }
+
+        // Checkpoint, if it is due
+        if (checkpoint_writer && timer.count<cxxtimer::ms>() / 1000.0 >= next_checkpoint) {
+            save_checkpoint();
+            next_checkpoint = timer.count<cxxtimer::ms>() / 1000.0 + settings.checkpoint_interval;
+        }
     }
 
-    // Decode the best solution found
+    if (verbose && gap_closed()) {
+        std::cout << "Gap closed: the best solution is within the tolerance of the lower bound." << std::endl;
+    }
+
+    // Final checkpoint (written before the writer is destroyed, when the function returns)
+    if (checkpoint_writer) save_checkpoint();
+
+    // Decode the best solution found (with the risk table, the incumbent: the best solutions of the pool were
+    // offered to it, and it is ranked by exact fitness)
+    const solution_t& best_start_time = risk_table ? incumbent.get().first : pool_solutions[idx_best];
     mpp::solution_t best_solution;
     for (size_t j = 0; j < n_var; ++j) {
-        best_solution[interventions[j]] = pool_solutions[idx_best][j];
+        best_solution[interventions[j]] = best_start_time[j];
     }
 
     // Evaluate the best solution and return it
@@ -2,13 +2,55 @@
 #define INCLUDE_MPP_SOLVER_DIFFERENTIAL_EVOLUTION_HPP_
 
 #include <tuple>
+#include <vector>
 #include <algorithm>
+#include <functional>
+#include <string>
+#include <cancellation.hpp>
+#include <deadline.hpp>
 #include <problem.hpp>
+#include <risk_table.hpp>
+#include <thread_pool.hpp>
+#include <solver/incumbent.hpp>
+#include <solver/lns.hpp>
+#include <solver/lagrangian.hpp>
 
 
 namespace mpp {
     namespace solver{
 
+        /**
+         * @brief Context of an improvement of the best solution.
+         * @param time Elapsed time (in seconds) since the start of the run.
+         * @param evaluations Number of solutions evaluated by the DE so far.
+         * @param lower_bound Best lower bound on the objective of the feasible solutions known so far.
+         * @param source Engine that found the solution: "initial" (initial solutions), "random" (random
+         * initial pool), "mip" (Relaxed MIP), "constructive" (constructive heuristic), "checkpoint" (resumed run),
+         * "lagrangian" (Lagrangian heuristic), "de" or "lns".
+         * @param mean_risk Mean risk of the solution (exact).
+         * @param expected_excess Expected excess of the solution (exact).
+         * @param exclusions Number of exclusion violations of the solution.
+         * @param resource_count Number of resource bound violations of the solution.
+         */
+        struct incumbent_event_t {
+            double time = 0.0;
+            long long int evaluations = 0;
+            double lower_bound = 0.0;
+            const char* source = "";
+            double mean_risk = 0.0;
+            double expected_excess = 0.0;
+            double exclusions = 0.0;
+            double resource_count = 0.0;
+        };
+
+        /**
+         * @brief Function called whenever the DE finds a new best solution.
+         * @param start_time Start time of each intervention (in the order of problem_t::get_intervention_names()).
+         * @param fitness Fitness of the solution.
+         * @param event When and by which engine the solution was found.
+         */
+        using incumbent_callback_t = std::function<void(const std::vector<int>& start_time, const fitness_t& fitness, const incumbent_event_t& event)>;
+
         /**
          * @brief Settings for the Differential Evolution (DE) solver.
          * @details This struct contains the parameters for the DE algorithm.
@@ -16,9 +58,45 @@ namespace mpp {
          * @param best1_ratio Probability of choosing DE/best/1 mutation strategy instead of DE/rand/1.
          * @param scaling_factor Scaling factor for mutation.
          * @param crossover_rho Rho parameter for crossover recombination.
+         * @param initial_solutions Solutions used to seed the pool and the MIP starts (e.g., from a previous run).
+         * Their start times are snapped to the allowed ones, and missing interventions get random start times.
+         * @param initial_mutation Probability of changing each start time in the mutated copies of the initial
+         * solutions that fill the rest of the pool.
          * @param timelimit Limits the runtime in seconds (default is 900 seconds, use -1 for no limit).
+         * @param deadline Wall-clock deadline shared with the other phases of the run (e.g., created at the start
+         * of the process). The run stops at the earliest of the deadline and the time limit, and the MIP and
+         * LNS get the remaining time as their limit.
+         * @param max_generations Limits the number of generations (-1 for no limit).
+         * @param gap Stops the run when the incumbent is feasible and its relative gap to the best lower bound
+         * (see lower_bound.hpp; the Relaxed MIP bound is used when available) is at most this value (-1 disables
+         * it). The default stops only when the incumbent is provably optimal.
          * @param mip_timelimit Limits the runtime of the MIP solver in seconds (-1 for no limit).
+         * @param mip_starts Number of solutions from the pool used as MIP starts (0 for a cold start).
          * @param threads Number of threads for parallel processing.
+         * @param thread_pool Thread pool shared with other solvers (optional, a pool is created for the run if null).
+         * @param repair Repair the trial vectors that changed before evaluating them (see repair_t): the interventions
+         * involved in resource or exclusion violations are moved to better start times, ties broken by mean risk
+         * (or by Lagrangian reduced cost, if the Lagrangian relaxation is enabled).
+         * @param repair_budget Maximum number of start times evaluated by the repair of a trial vector.
+         * @param lagrangian_iterations Number of subgradient iterations of the Lagrangian relaxation run after the
+         * seed solution (0 disables it). It improves the lower bound and the incumbent (Lagrangian heuristic), and
+         * is kept for the rest of the run.
+         * @param risk_precision Storage precision of the scenario risks used to rank the pool (see risk_table_t).
+         * With float32 or int16, the evaluations of the pool are faster and approximate in their objective; the best
+         * solutions are re-scored in double precision before they reach the incumbent, so the reported objectives
+         * are exact.
+         * @param lns_stall Number of generations without improvement before running the LNS (0 disables it).
+         * @param lns Settings of the LNS run when the DE stalls.
+         * @param on_incumbent Called from the thread running the DE whenever the best solution improves (optional).
+         * @param checkpoint Path to a checkpoint file, written periodically and at the end of the run (optional,
+         * none if empty). Snapshots are taken between generations and written in a background thread.
+         * @param checkpoint_interval Time (in seconds) between checkpoints.
+         * @param resume Path to a checkpoint file from which the run is resumed (optional, none if empty). The pool,
+         * the random number generators, the counters and the incumbent are restored, and the elapsed time of the
+         * previous runs counts against the time limit. The instance and the pool size must be the ones of the
+         * checkpointed run.
+         * @param cancellation Stops the run when cancelled (the current generation is cut short and the MIP solves
+         * are interrupted); the best solution found so far is returned.
          * @param seed Random seed for generating a random solution.
          * @param verbose Enable verbose output.
          */
@@ -27,9 +105,27 @@ namespace mpp {
             double best1_ratio = 0.37;
             double scaling_factor = 0.16;
             double crossover_rho = 0.3;
+            std::vector<solution_t> initial_solutions = {};
+            double initial_mutation = 0.05;
             long long int timelimit = 900;
+            deadline_t deadline = deadline_t();
+            long long int max_generations = -1;
+            double gap = 0.0;
             long long int mip_timelimit = -1;
+            size_t mip_starts = 4;
             int threads = 2;
+            thread_pool_t* thread_pool = nullptr;
+            bool repair = false;
+            long long int repair_budget = 1000;
+            long long int lagrangian_iterations = 0;
+            risk_precision_t risk_precision = risk_precision_t::float64;
+            long long int lns_stall = 100;
+            lns_settings_t lns = lns_settings_t();
+            incumbent_callback_t on_incumbent = nullptr;
+            std::string checkpoint = "";
+            double checkpoint_interval = 60.0;
+            std::string resume = "";
+            cancellation_token_t cancellation = cancellation_token_t();
             unsigned int seed = 0;
             bool verbose = true;
         };
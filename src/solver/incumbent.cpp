@@ -0,0 +1,35 @@
+#include <solver/incumbent.hpp>
+
+
+bool
+mpp::solver::incumbent_t::update(const std::vector<int>& start_time, const fitness_t& fitness) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (start_time_.empty() || fitness < fitness_) {
+        start_time_ = start_time;
+        fitness_ = fitness;
+        return true;
+    }
+
+    return false;
+}
+
+
+std::pair<std::vector<int>, mpp::solver::fitness_t>
+mpp::solver::incumbent_t::get() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return { start_time_, fitness_ };
+}
+
+
+mpp::solver::fitness_t
+mpp::solver::incumbent_t::fitness() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return fitness_;
+}
+
+
+bool
+mpp::solver::incumbent_t::empty() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return start_time_.empty();
+}
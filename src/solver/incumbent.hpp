@@ -0,0 +1,75 @@
+#ifndef INCLUDE_MPP_SOLVER_INCUMBENT_HPP_
+#define INCLUDE_MPP_SOLVER_INCUMBENT_HPP_
+
+#include <tuple>
+#include <vector>
+#include <mutex>
+#include <utility>
+#include <problem.hpp>
+
+
+namespace mpp {
+    namespace solver {
+
+        /**
+         * @brief Fitness of a solution, compared lexicographically.
+         * @details The fitness is a tuple of (exclusions + resource_count, resource_sum, objective).
+         */
+        using fitness_t = std::tuple<double, double, objective_t>;
+
+
+        /**
+         * @brief Compute the fitness of a solution from its evaluation.
+         * @param evaluation The evaluation of the solution, as returned by problem_t::evaluate.
+         * @return The fitness of the solution.
+         */
+        inline fitness_t
+        make_fitness(const std::tuple<objective_t, risk_metric_t, constraints_t>& evaluation) {
+            const auto& [objective, risk_metric, constraints] = evaluation;
+            const auto& [exclusions, resource_count, resource_sum] = constraints;
+            return std::make_tuple(exclusions + resource_count, resource_sum, objective);
+        }
+
+
+        /**
+         * @brief Best solution found so far, shared among solvers running concurrently.
+         * @details The solution is stored as a vector of start times, indexed in the same order
+         * as problem_t::get_intervention_names(). All methods are thread-safe.
+         */
+        class incumbent_t {
+            public:
+
+            /**
+             * @brief Replace the incumbent if the candidate is strictly better.
+             * @param start_time The start time of each intervention.
+             * @param fitness The fitness of the candidate solution.
+             * @return True if the incumbent was replaced.
+             */
+            bool update(const std::vector<int>& start_time, const fitness_t& fitness);
+
+            /**
+             * @brief Get a copy of the incumbent solution and its fitness.
+             */
+            std::pair<std::vector<int>, fitness_t> get() const;
+
+            /**
+             * @brief Get the fitness of the incumbent solution.
+             */
+            fitness_t fitness() const;
+
+            /**
+             * @brief Check whether a solution has already been set.
+             */
+            bool empty() const;
+
+            private:
+            mutable std::mutex mtx_;
+            std::vector<int> start_time_;
+            fitness_t fitness_;
+        };
+
+    } // namespace solver
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_SOLVER_INCUMBENT_HPP_
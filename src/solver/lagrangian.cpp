@@ -0,0 +1,228 @@
+#include <solver/lagrangian.hpp>
+#include <deadline.hpp>
+#include <stats.hpp>
+#include <trace.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <cxxtimer.hpp>
+
+
+mpp::solver::lagrangian_relaxation_t::lagrangian_relaxation_t(const mpp::problem_t& problem, const lagrangian_settings_t& settings)
+    : problem_(problem), settings_(settings), repair_(problem), bound_(-std::numeric_limits<double>::infinity()) {
+
+    // Multipliers of the upper and lower resource bounds (resource x period) and of the exclusion periods
+    n_resource_periods_ = problem.get_resource_names().size() * static_cast<size_t>(problem.get_T());
+    multipliers_.assign(2 * n_resource_periods_ + problem.get_exclusion_periods(), 0.0);
+    best_multipliers_ = multipliers_;
+}
+
+
+double
+mpp::solver::lagrangian_relaxation_t::cost(size_t intervention, size_t k, const std::vector<double>& multipliers) const {
+    const int T = problem_.get_T();
+    const int start_time = problem_.get_allowed_starts(intervention)[k];
+
+    double value = problem_.get_mean_risk(intervention, start_time);
+    for (const auto& workload : problem_.get_workload(intervention, start_time)) {
+        const size_t rt = static_cast<size_t>(workload.resource) * T + workload.period;
+        value += (multipliers[rt] - multipliers[n_resource_periods_ + rt]) * workload.amount;
+    }
+    problem_.for_each_exclusion_period(intervention, start_time, [&](size_t e) {
+        value += multipliers[2 * n_resource_periods_ + e];
+    });
+    return value;
+}
+
+
+double
+mpp::solver::lagrangian_relaxation_t::solve_subproblems(const std::vector<double>& multipliers, std::vector<size_t>& choice) const {
+    const size_t n = problem_.get_intervention_names().size();
+    const int T = problem_.get_T();
+
+    // Start time of lowest reduced cost of each intervention (the subproblems are independent)
+    std::vector<double> value(n);
+    auto solve_subproblem = [&](size_t i) {
+        const size_t n_starts = problem_.get_allowed_starts(i).size();
+        choice[i] = 0;
+        value[i] = cost(i, 0, multipliers);
+        for (size_t k = 1; k < n_starts; ++k) {
+            const double c = cost(i, k, multipliers);
+            if (c < value[i]) {
+                value[i] = c;
+                choice[i] = k;
+            }
+        }
+    };
+
+    if (settings_.thread_pool != nullptr && settings_.threads > 1) {
+        settings_.thread_pool->parallel_for(n, solve_subproblem, settings_.threads);
+    } else {
+        for (size_t i = 0; i < n; ++i) solve_subproblem(i);
+    }
+
+    // Lagrangian function: the subproblem values plus the constant terms of the relaxed constraints
+    double bound = 0.0;
+    for (size_t i = 0; i < n; ++i) bound += value[i];
+    for (size_t r = 0; r < problem_.get_resource_names().size(); ++r) {
+        const auto& upper_bound = problem_.get_resource_upper_bound(r);
+        const auto& lower_bound = problem_.get_resource_lower_bound(r);
+        for (int t = 0; t < T; ++t) {
+            const size_t rt = r * T + t;
+            bound -= multipliers[rt] * upper_bound[t];
+            bound += multipliers[n_resource_periods_ + rt] * lower_bound[t];
+        }
+    }
+    for (size_t e = 2 * n_resource_periods_; e < multipliers.size(); ++e) {
+        bound -= multipliers[e];
+    }
+    return bound;
+}
+
+
+std::vector<int>
+mpp::solver::lagrangian_relaxation_t::repair(const std::vector<size_t>& choice, const std::vector<double>& multipliers) const {
+    std::vector<int> start_time(choice.size());
+    for (size_t i = 0; i < choice.size(); ++i) start_time[i] = problem_.get_allowed_starts(i)[choice[i]];
+
+    // Ties between equally feasible start times are broken by their reduced cost
+    repair_.repair(start_time, std::numeric_limits<long long int>::max(), [&](size_t i, int s) {
+        const auto& allowed_starts = problem_.get_allowed_starts(i);
+        return cost(i, static_cast<size_t>(std::lower_bound(allowed_starts.begin(), allowed_starts.end(), s) - allowed_starts.begin()), multipliers);
+    });
+    return start_time;
+}
+
+
+double
+mpp::solver::lagrangian_relaxation_t::mean_risk(const std::vector<int>& start_time) const {
+    double value = 0.0;
+    for (size_t i = 0; i < start_time.size(); ++i) value += problem_.get_mean_risk(i, start_time[i]);
+    return value;
+}
+
+
+long long int
+mpp::solver::lagrangian_relaxation_t::run(incumbent_t& incumbent, double timelimit) {
+    stats::scoped_timer_t timer_phase(stats::phase_t::lagrangian);
+    trace::span_t span("lagrangian");
+
+    const size_t n = problem_.get_intervention_names().size();
+    const int T = problem_.get_T();
+    const mpp::deadline_t deadline(timelimit);
+    cxxtimer::Timer timer(true);
+
+    // Best feasible mean risk known (the target of the step size)
+    double upper = std::numeric_limits<double>::infinity();
+    if (!incumbent.empty()) {
+        auto [incumbent_solution, incumbent_fitness] = incumbent.get();
+        if (std::get<0>(incumbent_fitness) == 0.0) upper = mean_risk(incumbent_solution);
+    }
+
+    long long int improvements = 0;
+    double step = settings_.step;
+    long long int stall = 0;
+    std::vector<size_t> choice(n);
+    std::vector<double> subgradient(multipliers_.size());
+    std::vector<double> usage(n_resource_periods_);
+
+    for (long long int iteration = 0; iteration < settings_.iterations; ++iteration) {
+        if (deadline.expired() || settings_.cancellation.cancelled()) break;
+        stats::count(stats::counter_t::lagrangian_iterations);
+
+        // Solve the relaxation with the current multipliers
+        const double value = solve_subproblems(multipliers_, choice);
+        if (value > bound_) {
+            bound_ = value;
+            best_multipliers_ = multipliers_;
+            relaxed_solution_.resize(n);
+            for (size_t i = 0; i < n; ++i) relaxed_solution_[i] = problem_.get_allowed_starts(i)[choice[i]];
+            stall = 0;
+        } else if (++stall >= settings_.step_patience) {
+            step /= 2.0;
+            stall = 0;
+        }
+
+        // Lagrangian heuristic: repair the relaxed schedule and share it
+        if (iteration % std::max<long long int>(1, settings_.heuristic_interval) == 0) {
+            std::vector<int> candidate = repair(choice, multipliers_);
+            fitness_t candidate_fitness = make_fitness(problem_.evaluate(candidate));
+            if (std::get<0>(candidate_fitness) == 0.0) upper = std::min(upper, mean_risk(candidate));
+            if (incumbent.update(candidate, candidate_fitness)) ++improvements;
+
+            if (settings_.verbose) {
+                std::cout << "Lagrangian | " << iteration + 1 << " | "
+                          << std::fixed << std::setprecision(5) << timer.count<cxxtimer::ms>() / 1000.0 << " | "
+                          << value << " | " << bound_ << " | " << upper << std::endl;
+            }
+        }
+
+        // The bound meets the best feasible solution: it is optimal for the mean risk
+        if (bound_ >= upper - 1e-9 * std::max(1.0, std::abs(upper))) break;
+        if (step < settings_.min_step) break;
+
+        // Subgradient of the relaxed constraints at the relaxed schedule (projected on the multipliers at 0)
+        std::fill(usage.begin(), usage.end(), 0.0);
+        std::fill(subgradient.begin() + 2 * n_resource_periods_, subgradient.end(), -1.0);
+        for (size_t i = 0; i < n; ++i) {
+            for (const auto& workload : problem_.get_workload(i, problem_.get_allowed_starts(i)[choice[i]])) {
+                usage[static_cast<size_t>(workload.resource) * T + workload.period] += workload.amount;
+            }
+            problem_.for_each_exclusion_period(i, problem_.get_allowed_starts(i)[choice[i]], [&](size_t e) {
+                subgradient[2 * n_resource_periods_ + e] += 1.0;
+            });
+        }
+        for (size_t r = 0; r < problem_.get_resource_names().size(); ++r) {
+            const auto& upper_bound = problem_.get_resource_upper_bound(r);
+            const auto& lower_bound = problem_.get_resource_lower_bound(r);
+            for (int t = 0; t < T; ++t) {
+                const size_t rt = r * T + t;
+                subgradient[rt] = usage[rt] - upper_bound[t];
+                subgradient[n_resource_periods_ + rt] = lower_bound[t] - usage[rt];
+            }
+        }
+
+        double norm = 0.0;
+        for (size_t j = 0; j < multipliers_.size(); ++j) {
+            if (multipliers_[j] <= 0.0 && subgradient[j] < 0.0) subgradient[j] = 0.0;
+            norm += subgradient[j] * subgradient[j];
+        }
+
+        // The relaxed schedule satisfies the relaxed constraints with complementary slackness: it is optimal
+        if (norm == 0.0) break;
+
+        // Polyak step towards the best feasible mean risk (or, without one, slightly above the current value)
+        const double target = std::isinf(upper) ? value + std::max(0.1 * std::abs(value), 1e-6) : upper;
+        const double length = step * std::max(target - value, 1e-9 * std::max(1.0, std::abs(value))) / norm;
+        for (size_t j = 0; j < multipliers_.size(); ++j) {
+            multipliers_[j] = std::max(0.0, multipliers_[j] + length * subgradient[j]);
+        }
+    }
+
+    return improvements;
+}
+
+
+double
+mpp::solver::lagrangian_relaxation_t::bound() const {
+    return bound_;
+}
+
+
+double
+mpp::solver::lagrangian_relaxation_t::reduced_cost(size_t intervention, int start_time) const {
+    const auto& allowed_starts = problem_.get_allowed_starts(intervention);
+    auto it = std::lower_bound(allowed_starts.begin(), allowed_starts.end(), start_time);
+    if (it == allowed_starts.end() || *it != start_time) return std::numeric_limits<double>::infinity();
+    return cost(intervention, static_cast<size_t>(it - allowed_starts.begin()), best_multipliers_);
+}
+
+
+const std::vector<int>&
+mpp::solver::lagrangian_relaxation_t::relaxed_solution() const {
+    return relaxed_solution_;
+}
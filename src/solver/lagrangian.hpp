@@ -0,0 +1,109 @@
+#ifndef INCLUDE_MPP_SOLVER_LAGRANGIAN_HPP_
+#define INCLUDE_MPP_SOLVER_LAGRANGIAN_HPP_
+
+#include <vector>
+#include <cancellation.hpp>
+#include <problem.hpp>
+#include <thread_pool.hpp>
+#include <solver/incumbent.hpp>
+#include <solver/repair.hpp>
+
+
+namespace mpp {
+    namespace solver {
+
+        /**
+         * @brief Settings for the Lagrangian relaxation.
+         * @param iterations Maximum number of subgradient iterations.
+         * @param step Initial step factor of the subgradient method (Polyak step, between 0 and 2).
+         * @param step_patience Number of iterations without improvement of the bound before the step factor is halved.
+         * @param min_step The run stops when the step factor falls below this value.
+         * @param heuristic_interval Number of iterations between two runs of the Lagrangian heuristic.
+         * @param threads Number of threads solving the subproblems (one per intervention) in parallel.
+         * @param thread_pool Thread pool shared with other solvers (optional, the subproblems are solved by the
+         * calling thread if null).
+         * @param cancellation Stops the run before the next iteration when cancelled.
+         * @param verbose Enable verbose output.
+         */
+        struct lagrangian_settings_t {
+            long long int iterations = 200;
+            double step = 2.0;
+            long long int step_patience = 20;
+            double min_step = 1e-4;
+            long long int heuristic_interval = 10;
+            int threads = 1;
+            thread_pool_t* thread_pool = nullptr;
+            cancellation_token_t cancellation = cancellation_token_t();
+            bool verbose = false;
+        };
+
+
+        /**
+         * @brief Lagrangian relaxation of the resource and exclusion constraints of the mean risk model.
+         * @details The model is the one of the Relaxed MIP: minimize the mean risk subject to the resource
+         * bounds and the exclusions. Relaxing these constraints with multipliers makes it separable: each
+         * intervention takes the start time of lowest reduced cost (mean risk plus the multipliers of the
+         * resources and exclusion periods it uses). The multipliers are optimized with the projected
+         * subgradient method (Polyak step), and each bound is a valid lower bound on the mean risk of the
+         * feasible solutions. Periodically, a Lagrangian heuristic repairs the relaxed schedule into a feasible
+         * one (see repair_t, ties broken by reduced cost), and improving solutions are written to the shared
+         * incumbent.
+         * The multipliers of the best bound are kept, and their reduced costs can guide other heuristics.
+         */
+        class lagrangian_relaxation_t {
+            public:
+
+            /**
+             * @brief Create the relaxation for a problem instance (with zero multipliers).
+             * @param problem The maintenance planning problem instance.
+             * @param settings The Lagrangian settings (optional).
+             */
+            lagrangian_relaxation_t(const problem_t& problem, const lagrangian_settings_t& settings = lagrangian_settings_t());
+
+            /**
+             * @brief Optimize the multipliers, starting from the current ones.
+             * @param incumbent The shared incumbent solution, improved by the Lagrangian heuristic (its mean risk
+             * is also the target of the step size, if it is feasible).
+             * @param timelimit Limits the runtime in seconds (-1 for no limit).
+             * @return The number of improvements of the incumbent.
+             */
+            long long int run(incumbent_t& incumbent, double timelimit = -1);
+
+            /**
+             * @brief Best lower bound on the mean risk of the feasible solutions found so far.
+             */
+            double bound() const;
+
+            /**
+             * @brief Reduced cost of an intervention at a start time, with the multipliers of the best bound.
+             * @details The mean risk of the intervention plus the cost of the resources and exclusion periods it
+             * uses. Lower is more promising for the relaxation.
+             */
+            double reduced_cost(size_t intervention, int start_time) const;
+
+            /**
+             * @brief Start times of the relaxed schedule (optimal for the subproblems) at the best bound.
+             */
+            const std::vector<int>& relaxed_solution() const;
+
+            private:
+            double solve_subproblems(const std::vector<double>& multipliers, std::vector<size_t>& choice) const;
+            double cost(size_t intervention, size_t k, const std::vector<double>& multipliers) const;
+            std::vector<int> repair(const std::vector<size_t>& choice, const std::vector<double>& multipliers) const;
+            double mean_risk(const std::vector<int>& start_time) const;
+
+            const problem_t& problem_;
+            lagrangian_settings_t settings_;
+            repair_t repair_;                                           // Lagrangian heuristic (and exclusion periods)
+            size_t n_resource_periods_ = 0;                             // Multipliers of the resource bounds (resource x period)
+            std::vector<double> multipliers_;                           // Upper bounds, lower bounds, then exclusion periods
+            std::vector<double> best_multipliers_;
+            double bound_;
+            std::vector<int> relaxed_solution_;
+        };
+
+    } // namespace solver
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_SOLVER_LAGRANGIAN_HPP_
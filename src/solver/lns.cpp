@@ -0,0 +1,211 @@
+#include <solver/lns.hpp>
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <cxxtimer.hpp>
+
+
+namespace {
+
+    bool intersects(const std::vector<int>& a, const std::vector<int>& b) {
+        auto it_a = a.begin();
+        auto it_b = b.begin();
+        while (it_a != a.end() && it_b != b.end()) {
+            if (*it_a == *it_b) return true;
+            if (*it_a < *it_b) ++it_a; else ++it_b;
+        }
+        return false;
+    }
+
+} // namespace
+
+
+mpp::solver::large_neighborhood_search_t::large_neighborhood_search_t(const mpp::problem_t& problem, const lns_settings_t& settings)
+    : problem_(problem), settings_(settings) {
+
+    const size_t n = problem.get_intervention_names().size();
+    const auto& exclusions = problem.get_exclusions();
+
+    resources_.resize(n);
+    seasons_.resize(n);
+
+    // Relations among interventions used to build the neighborhoods (sorted, without duplicates): the
+    // resources used at any start time, and the season periods of the exclusions involving each intervention
+    for (size_t i = 0; i < n; ++i) {
+        for (int start_time = 1; start_time <= problem.get_tmax(i); ++start_time) {
+            for (const auto& workload : problem.get_workload(i, start_time)) resources_[i].push_back(workload.resource);
+        }
+        for (size_t e : problem.get_intervention_exclusions(i)) {
+            seasons_[i].insert(seasons_[i].end(), exclusions[e].season.begin(), exclusions[e].season.end());
+        }
+        for (auto* related : { &resources_[i], &seasons_[i] }) {
+            std::sort(related->begin(), related->end());
+            related->erase(std::unique(related->begin(), related->end()), related->end());
+        }
+    }
+
+    contexts_.resize(std::max(1, settings_.workers));
+    if (settings_.thread_pool == nullptr && contexts_.size() > 1) {
+        own_thread_pool_ = std::make_unique<mpp::thread_pool_t>(contexts_.size() - 1);
+    }
+}
+
+
+mpp::solver::large_neighborhood_search_t::~large_neighborhood_search_t() {
+    // Does nothing here.
+}
+
+
+long long int
+mpp::solver::large_neighborhood_search_t::run(incumbent_t& incumbent, double timelimit, unsigned int seed) {
+
+    // Start the timer
+    cxxtimer::Timer timer(true);
+
+    const size_t n = problem_.get_intervention_names().size();
+    const size_t neighborhood_size = settings_.neighborhood_size;
+
+    // Build the context of the first worker in the calling thread, so that a missing
+    // Gurobi license is reported to the caller (throws GRBException)
+    if (!contexts_[0]) {
+        contexts_[0] = std::make_unique<mip_context_t>(problem_, settings_.threads, false);
+        contexts_[0]->set_cancellation(settings_.cancellation);
+    }
+
+    std::atomic<long long int> improvements(0);
+    std::mutex mtx_output;
+
+    // Select the interventions to free in a sub-MIP.
+    // A seed intervention is drawn at random, and the neighborhood is filled with interventions
+    // related to it by one of the following criteria (also drawn at random): shared resources,
+    // overlapping exclusion seasons or overlapping time ranges in the current solution. If not enough
+    // related interventions exist, the neighborhood is completed with random interventions.
+    auto select_neighborhood = [&](const std::vector<int>& start_time, std::mt19937& rng) {
+        std::vector<bool> freed(n, false);
+        if (neighborhood_size >= n) {
+            freed.assign(n, true);
+            return freed;
+        }
+
+        const size_t seed_idx = rng() % n;
+        const int criterion = rng() % 3;
+        const int seed_begin = start_time[seed_idx];
+        const int seed_end = start_time[seed_idx] + problem_.get_delta(seed_idx, start_time[seed_idx]) - 1;
+
+        std::vector<size_t> related;
+        for (size_t i = 0; i < n; ++i) {
+            if (i == seed_idx) continue;
+            bool is_related = false;
+            switch (criterion) {
+                case 0:
+                    is_related = intersects(resources_[seed_idx], resources_[i]);
+                    break;
+                case 1:
+                    is_related = intersects(seasons_[seed_idx], seasons_[i]);
+                    break;
+                default:
+                    is_related = (start_time[i] <= seed_end && start_time[i] + problem_.get_delta(i, start_time[i]) - 1 >= seed_begin);
+                    break;
+            }
+            if (is_related) related.push_back(i);
+        }
+
+        std::shuffle(related.begin(), related.end(), rng);
+        freed[seed_idx] = true;
+        size_t count = 1;
+        for (size_t k = 0; k < related.size() && count < neighborhood_size; ++k, ++count) {
+            freed[related[k]] = true;
+        }
+
+        while (count < neighborhood_size) {
+            size_t i = rng() % n;
+            if (!freed[i]) {
+                freed[i] = true;
+                ++count;
+            }
+        }
+
+        return freed;
+    };
+
+    // Each worker owns a MIP context and solves one sub-MIP at a time
+    auto worker = [&](int worker_id) {
+        try {
+            if (!contexts_[worker_id]) {
+                contexts_[worker_id] = std::make_unique<mip_context_t>(problem_, settings_.threads, false);
+                contexts_[worker_id]->set_cancellation(settings_.cancellation);
+            }
+            mip_context_t& context = *contexts_[worker_id];
+
+            std::mt19937 rng(seed + worker_id);
+
+            while (true) {
+                double remaining = timelimit - timer.count<cxxtimer::ms>() / 1000.0;
+                if (remaining <= 0.0 || settings_.cancellation.cancelled()) break;
+
+                // Select the neighborhood around the current incumbent
+                auto [start_time, fitness] = incumbent.get();
+                std::vector<bool> freed = select_neighborhood(start_time, rng);
+
+                // Specialize the model: interventions outside the neighborhood are fixed to the incumbent
+                for (size_t i = 0; i < n; ++i) {
+                    if (freed[i]) {
+                        context.unfix(i);
+                    } else {
+                        context.fix(i, start_time[i]);
+                    }
+                }
+                context.set_starts({ start_time });
+
+                if (!context.solve(std::min(settings_.subproblem_timelimit, remaining))) continue;
+
+                // Evaluate the sub-MIP solution and share it if it improves the incumbent
+                std::vector<int> candidate = context.get_solution();
+                fitness_t candidate_fitness = make_fitness(problem_.evaluate(candidate));
+                if (incumbent.update(candidate, candidate_fitness)) {
+                    ++improvements;
+                    if (settings_.verbose) {
+                        const auto& [violated_constraints, exceeded_resources, objective] = candidate_fitness;
+                        std::lock_guard<std::mutex> lock(mtx_output);
+                        std::cout << "LNS | "
+                                  << std::fixed << std::setprecision(5) << timer.count<cxxtimer::ms>() / 1000.0 << " | "
+                                  << violated_constraints << " | "
+                                  << exceeded_resources << " | "
+                                  << objective << std::endl;
+                    }
+                }
+            }
+
+        } catch (const std::exception& e) {
+            if (settings_.verbose) {
+                std::lock_guard<std::mutex> lock(mtx_output);
+                std::cout << "LNS worker " << worker_id << " stopped: " << e.what() << std::endl;
+            }
+        } catch (...) {
+            if (settings_.verbose) {
+                std::lock_guard<std::mutex> lock(mtx_output);
+                std::cout << "LNS worker " << worker_id << " stopped." << std::endl;
+            }
+        }
+    };
+
+    // Solve the sub-MIPs concurrently, in the calling thread and the thread pool
+    mpp::thread_pool_t* thread_pool = settings_.thread_pool ? settings_.thread_pool : own_thread_pool_.get();
+    if (thread_pool != nullptr) {
+        thread_pool->parallel_for(contexts_.size(), [&](size_t w) { worker(static_cast<int>(w)); }, contexts_.size());
+    } else {
+        worker(0);
+    }
+
+    return improvements;
+}
+
+
+long long int
+mpp::solver::large_neighborhood_search(const mpp::problem_t& problem, incumbent_t& incumbent, const lns_settings_t& settings) {
+    large_neighborhood_search_t lns(problem, settings);
+    return lns.run(incumbent, settings.timelimit, settings.seed);
+}
@@ -0,0 +1,97 @@
+#ifndef INCLUDE_MPP_SOLVER_LNS_HPP_
+#define INCLUDE_MPP_SOLVER_LNS_HPP_
+
+#include <memory>
+#include <vector>
+#include <cancellation.hpp>
+#include <problem.hpp>
+#include <solver/incumbent.hpp>
+#include <solver/mip_context.hpp>
+#include <thread_pool.hpp>
+
+
+namespace mpp {
+    namespace solver {
+
+        /**
+         * @brief Settings for the MIP-based Large Neighborhood Search (LNS).
+         * @details This struct contains the parameters for the fix-and-optimize LNS.
+         * @param timelimit Limits the runtime in seconds.
+         * @param subproblem_timelimit Limits the runtime of each sub-MIP in seconds.
+         * @param neighborhood_size Number of interventions freed in each sub-MIP.
+         * @param workers Number of sub-MIPs solved concurrently (each one with its own Gurobi environment).
+         * @param threads Number of threads used by Gurobi to solve each sub-MIP.
+         * @param thread_pool Shared pool running the workers, with the calling thread (optional: the LNS owns a
+         * pool of workers - 1 threads if null). The workers are bounded by the time limit of the run, so a worker
+         * that starts late because the pool is busy only uses the time left.
+         * @param seed Random seed for selecting the neighborhoods.
+         * @param cancellation Stops the run before the next sub-MIP when cancelled.
+         * @param verbose Enable verbose output.
+         */
+        struct lns_settings_t {
+            double timelimit = 30.0;
+            double subproblem_timelimit = 5.0;
+            size_t neighborhood_size = 20;
+            int workers = 2;
+            int threads = 1;
+            thread_pool_t* thread_pool = nullptr;
+            unsigned int seed = 0;
+            cancellation_token_t cancellation = cancellation_token_t();
+            bool verbose = false;
+        };
+
+
+        /**
+         * @brief MIP-based Large Neighborhood Search (fix-and-optimize) for the maintenance planning problem.
+         * @details Repeatedly frees a subset of interventions related by shared resources, overlapping exclusion
+         * seasons or overlapping time ranges, fixes the remaining ones to the incumbent and solves the
+         * resulting sub-MIP. Improving solutions are written back to the shared incumbent.
+         * Each worker owns a persistent MIP context (with its own Gurobi environment), which is built
+         * on the first run and reused by the following ones.
+         */
+        class large_neighborhood_search_t {
+            public:
+
+            /**
+             * @brief Create the LNS for a problem instance.
+             * @param problem The maintenance planning problem instance.
+             * @param settings The LNS settings (optional).
+             */
+            large_neighborhood_search_t(const problem_t& problem, const lns_settings_t& settings = lns_settings_t());
+            ~large_neighborhood_search_t();
+
+            /**
+             * @brief Run the LNS on the shared incumbent.
+             * @param incumbent The shared incumbent solution (must not be empty).
+             * @param timelimit Limits the runtime in seconds.
+             * @param seed Random seed for selecting the neighborhoods.
+             * @return The number of improvements found.
+             */
+            long long int run(incumbent_t& incumbent, double timelimit, unsigned int seed);
+
+            private:
+            const problem_t& problem_;
+            lns_settings_t settings_;
+            std::vector< std::vector<int> > resources_;     // Resources used by each intervention
+            std::vector< std::vector<int> > seasons_;       // Season periods of the exclusions involving each intervention
+            std::vector< std::unique_ptr<mip_context_t> > contexts_;
+            std::unique_ptr<thread_pool_t> own_thread_pool_;   // Runs the workers if no shared pool is given
+        };
+
+
+        /**
+         * @brief Run the MIP-based Large Neighborhood Search once.
+         * @param problem The maintenance planning problem instance.
+         * @param incumbent The shared incumbent solution (must not be empty).
+         * @param settings The LNS settings (optional).
+         * @return The number of improvements found.
+         */
+        long long int
+        large_neighborhood_search(const problem_t& problem, incumbent_t& incumbent,
+            const lns_settings_t& settings = lns_settings_t());
+
+    } // namespace solver
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_SOLVER_LNS_HPP_
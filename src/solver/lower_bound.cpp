@@ -0,0 +1,32 @@
+#include <solver/lower_bound.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+double
+mpp::solver::separable_lower_bound(const mpp::problem_t& problem) {
+    double mean_risk_bound = 0.0;
+    for (size_t i = 0; i < problem.get_intervention_names().size(); ++i) {
+        double lowest = std::numeric_limits<double>::infinity();
+        for (int start_time : problem.get_allowed_starts(i)) {
+            lowest = std::min(lowest, problem.get_mean_risk(i, start_time));
+        }
+        mean_risk_bound += lowest;
+    }
+    return objective_lower_bound(problem, mean_risk_bound);
+}
+
+
+double
+mpp::solver::objective_lower_bound(const mpp::problem_t& problem, double mean_risk_bound) {
+    const double alpha = problem.get_data()[mpp::params::ALPHA].template get<double>();
+    return (alpha > 0.0) ? alpha * mean_risk_bound : 0.0;
+}
+
+
+double
+mpp::solver::relative_gap(double objective, double lower_bound) {
+    if (objective == lower_bound) return 0.0;
+    return (objective - lower_bound) / std::max(std::abs(objective), 1e-10);
+}
@@ -0,0 +1,42 @@
+#ifndef INCLUDE_MPP_SOLVER_LOWER_BOUND_HPP_
+#define INCLUDE_MPP_SOLVER_LOWER_BOUND_HPP_
+
+#include <problem.hpp>
+
+
+namespace mpp {
+    namespace solver {
+
+        /**
+         * @brief Lower bound on the objective of the feasible solutions, from the separable part of the objective.
+         * @details The objective is alpha * mean_risk + (1 - alpha) * expected_excess. The expected excess is
+         * non-negative and the mean risk is a sum of one term per intervention, so alpha times the sum of the
+         * lowest mean risk of each intervention (over its allowed start times) is a valid bound. It ignores the
+         * resource and exclusion constraints, so it is weak on tight instances, but it costs a single pass over
+         * the compiled data.
+         * @param problem The maintenance planning problem instance.
+         * @return The lower bound.
+         */
+        double separable_lower_bound(const problem_t& problem);
+
+        /**
+         * @brief Lower bound on the objective of the feasible solutions, from a bound on the mean risk.
+         * @details Any bound on the mean risk of the feasible solutions (e.g., the best bound of the relaxed MIP,
+         * whose objective is the mean risk, or a Lagrangian bound) gives the bound alpha * mean_risk_bound.
+         * @param problem The maintenance planning problem instance.
+         * @param mean_risk_bound Lower bound on the mean risk of the feasible solutions.
+         * @return The lower bound.
+         */
+        double objective_lower_bound(const problem_t& problem, double mean_risk_bound);
+
+        /**
+         * @brief Relative gap between the objective of a solution and a lower bound.
+         * @return (objective - lower_bound) / |objective| (0 if both are 0).
+         */
+        double relative_gap(double objective, double lower_bound);
+
+    } // namespace solver
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_SOLVER_LOWER_BOUND_HPP_
@@ -0,0 +1,198 @@
+#include <solver/mip_context.hpp>
+#include <stats.hpp>
+#include <trace.hpp>
+#include <solver/relaxed_mip_model.hpp>
+#include <gurobi_c++.h>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+    /**
+     * @brief Gurobi callback that interrupts the solve when a token is cancelled.
+     */
+    class cancellation_callback_t : public GRBCallback {
+        public:
+        explicit cancellation_callback_t(const mpp::cancellation_token_t& cancellation) : cancellation(cancellation) { }
+
+        protected:
+        void callback() override {
+            if (cancellation.cancelled()) abort();
+        }
+
+        private:
+        mpp::cancellation_token_t cancellation;
+    };
+
+} // namespace
+
+
+struct mpp::solver::mip_context_t::impl_t {
+
+    impl_t(const ::mpp::problem_t& problem, int threads, bool verbose)
+        : problem(problem), threads(threads), verbose(verbose), env(true) {
+
+        // Start the Gurobi environment (throws GRBException if no license is available)
+        env.set(GRB_IntParam_OutputFlag, 0);
+        env.start();
+
+        // Build the model once
+        model = std::make_unique<GRBModel>(env);
+        x = build_relaxed_mip_model(*model, problem);
+        for (const auto& intervention_name : problem.get_intervention_names()) {
+            x_by_index.push_back(&x[intervention_name]);
+        }
+        model->update();
+    }
+
+    const ::mpp::problem_t& problem;
+    int threads;
+    bool verbose;
+    GRBEnv env;
+    std::unique_ptr<GRBModel> model;
+    mip_variables_t x;
+    std::vector< std::map<int, GRBVar>* > x_by_index;
+    std::map<int, GRBConstr> cuts;
+    int next_cut_id = 0;
+    std::unique_ptr<cancellation_callback_t> callback;
+};
+
+
+mpp::solver::mip_context_t::mip_context_t(const ::mpp::problem_t& problem, int threads, bool verbose)
+    : impl_(std::make_unique<impl_t>(problem, threads, verbose)) {
+    // Does nothing here.
+}
+
+
+mpp::solver::mip_context_t::~mip_context_t() {
+    // Does nothing here.
+}
+
+
+void
+mpp::solver::mip_context_t::fix(size_t intervention, int start_time) {
+    for (auto& [t, x_t] : *impl_->x_by_index[intervention]) {
+        x_t.set(GRB_DoubleAttr_LB, (t == start_time ? 1.0 : 0.0));
+        x_t.set(GRB_DoubleAttr_UB, (t == start_time ? 1.0 : 0.0));
+    }
+}
+
+
+void
+mpp::solver::mip_context_t::unfix(size_t intervention) {
+    for (auto& [t, x_t] : *impl_->x_by_index[intervention]) {
+        x_t.set(GRB_DoubleAttr_LB, 0.0);
+        x_t.set(GRB_DoubleAttr_UB, 1.0);
+    }
+}
+
+
+void
+mpp::solver::mip_context_t::unfix_all() {
+    for (size_t i = 0; i < impl_->x_by_index.size(); ++i) {
+        unfix(i);
+    }
+}
+
+
+int
+mpp::solver::mip_context_t::add_cut(const std::vector<cut_term_t>& terms, char sense, double rhs) {
+    GRBLinExpr expr = 0;
+    for (const auto& term : terms) {
+        expr += term.coefficient * impl_->x_by_index[term.intervention]->at(term.start_time);
+    }
+
+    const char grb_sense = (sense == '<' ? GRB_LESS_EQUAL : (sense == '>' ? GRB_GREATER_EQUAL : GRB_EQUAL));
+    int cut_id = impl_->next_cut_id++;
+    impl_->cuts.emplace(cut_id, impl_->model->addConstr(expr, grb_sense, rhs));
+    return cut_id;
+}
+
+
+void
+mpp::solver::mip_context_t::remove_cut(int cut_id) {
+    auto it = impl_->cuts.find(cut_id);
+    if (it != impl_->cuts.end()) {
+        impl_->model->remove(it->second);
+        impl_->cuts.erase(it);
+    }
+}
+
+
+void
+mpp::solver::mip_context_t::set_starts(const std::vector< std::vector<int> >& start_times) {
+    impl_->model->set(GRB_IntAttr_NumStart, static_cast<int>(start_times.size()));
+    impl_->model->update();
+    for (size_t k = 0; k < start_times.size(); ++k) {
+        impl_->model->set(GRB_IntParam_StartNumber, static_cast<int>(k));
+        for (size_t i = 0; i < impl_->x_by_index.size(); ++i) {
+            for (auto& [t, x_t] : *impl_->x_by_index[i]) {
+                x_t.set(GRB_DoubleAttr_Start, (t == start_times[k][i] ? 1.0 : 0.0));
+            }
+        }
+    }
+}
+
+
+void
+mpp::solver::mip_context_t::clear_starts() {
+    impl_->model->set(GRB_IntAttr_NumStart, 0);
+    impl_->model->update();
+}
+
+
+bool
+mpp::solver::mip_context_t::solve(double timelimit) {
+    stats::scoped_timer_t timer(stats::phase_t::mip_solve);
+    trace::span_t span("mip_solve");
+    stats::count(stats::counter_t::mip_solves);
+
+    configure_relaxed_mip_model(*impl_->model, timelimit, impl_->threads, impl_->verbose);
+    impl_->model->optimize();
+    return impl_->model->get(GRB_IntAttr_SolCount) > 0;
+}
+
+
+void
+mpp::solver::mip_context_t::set_cancellation(const cancellation_token_t& cancellation) {
+    impl_->callback = std::make_unique<cancellation_callback_t>(cancellation);
+    impl_->model->setCallback(impl_->callback.get());
+}
+
+
+double
+mpp::solver::mip_context_t::get_bound() const {
+    const int status = impl_->model->get(GRB_IntAttr_Status);
+    if (status == GRB_INFEASIBLE) return std::numeric_limits<double>::infinity();
+    try {
+        return impl_->model->get(GRB_DoubleAttr_ObjBound);
+    } catch (const GRBException&) {
+        return -std::numeric_limits<double>::infinity();
+    }
+}
+
+
+std::vector<int>
+mpp::solver::mip_context_t::get_solution() const {
+    std::vector<int> start_time(impl_->x_by_index.size(), 1);
+    for (size_t i = 0; i < impl_->x_by_index.size(); ++i) {
+        for (const auto& [t, x_t] : *impl_->x_by_index[i]) {
+            if (x_t.get(GRB_DoubleAttr_X) > 0.5) {
+                start_time[i] = t;
+                break;
+            }
+        }
+    }
+
+    return start_time;
+}
+
+
+const mpp::problem_t&
+mpp::solver::mip_context_t::get_problem() const {
+    return impl_->problem;
+}
@@ -0,0 +1,127 @@
+#ifndef INCLUDE_MPP_SOLVER_MIP_CONTEXT_HPP_
+#define INCLUDE_MPP_SOLVER_MIP_CONTEXT_HPP_
+
+#include <memory>
+#include <vector>
+#include <cancellation.hpp>
+#include <problem.hpp>
+
+
+namespace mpp {
+    namespace solver {
+
+        /**
+         * @brief Term of a cut over the assignment variables of the relaxed MIP.
+         * @param intervention Index of the intervention (as in problem_t::get_intervention_names()).
+         * @param start_time Start time of the intervention.
+         * @param coefficient Coefficient of the assignment variable in the cut.
+         */
+        struct cut_term_t {
+            size_t intervention;
+            int start_time;
+            double coefficient;
+        };
+
+
+        /**
+         * @brief Persistent context for repeated solves of the relaxed MIP.
+         * @details Owns a Gurobi environment and the relaxed MIP model, which are built only once.
+         * Successive solves are specialized by fixing interventions (variable bounds), adding or
+         * removing cuts and setting MIP starts, without rebuilding the model. A context is not
+         * thread-safe: concurrent solves must use separate contexts.
+         */
+        class mip_context_t {
+            public:
+
+            /**
+             * @brief Create the Gurobi environment and build the relaxed MIP model.
+             * @param problem The maintenance planning problem instance.
+             * @param threads Number of threads used by Gurobi.
+             * @param verbose Enable the Gurobi log.
+             */
+            mip_context_t(const problem_t& problem, int threads = 1, bool verbose = false);
+            ~mip_context_t();
+
+            mip_context_t(const mip_context_t&) = delete;
+            mip_context_t& operator=(const mip_context_t&) = delete;
+
+            /**
+             * @brief Fix the start time of an intervention.
+             */
+            void fix(size_t intervention, int start_time);
+
+            /**
+             * @brief Release the start time of an intervention.
+             */
+            void unfix(size_t intervention);
+
+            /**
+             * @brief Release the start time of all interventions.
+             */
+            void unfix_all();
+
+            /**
+             * @brief Add a cut (linear constraint) over the assignment variables.
+             * @param terms The terms of the left-hand side.
+             * @param sense The sense of the cut ('<', '>' or '=').
+             * @param rhs The right-hand side.
+             * @return An identifier to remove the cut later.
+             */
+            int add_cut(const std::vector<cut_term_t>& terms, char sense, double rhs);
+
+            /**
+             * @brief Remove a cut previously added with add_cut.
+             */
+            void remove_cut(int cut_id);
+
+            /**
+             * @brief Set the MIP starts used by the next solve.
+             * @param start_times Start times of the interventions, one vector per MIP start.
+             */
+            void set_starts(const std::vector< std::vector<int> >& start_times);
+
+            /**
+             * @brief Discard all MIP starts.
+             */
+            void clear_starts();
+
+            /**
+             * @brief Solve the model with the current fixings, cuts and MIP starts.
+             * @param timelimit Limits the runtime in seconds (-1 for no limit).
+             * @return True if a solution was found.
+             */
+            bool solve(double timelimit = -1);
+
+            /**
+             * @brief Interrupt the solves when a token is cancelled (the best solution found so far is kept).
+             */
+            void set_cancellation(const cancellation_token_t& cancellation);
+
+            /**
+             * @brief Start times of the interventions in the solution found by the last solve.
+             */
+            std::vector<int> get_solution() const;
+
+            /**
+             * @brief Best bound on the objective (the mean risk) of the model found by the last solve.
+             * @details It is a bound for the model with the current fixings and cuts, so it is a bound for the
+             * whole problem only when nothing is fixed. Infinity if the model is infeasible and minus infinity
+             * if no bound is available (e.g., the solve was interrupted before the root node).
+             */
+            double get_bound() const;
+
+            /**
+             * @brief The problem instance the model was built from.
+             */
+            const problem_t& get_problem() const;
+
+            private:
+            struct impl_t;
+            std::unique_ptr<impl_t> impl_;
+        };
+
+    } // namespace solver
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_SOLVER_MIP_CONTEXT_HPP_
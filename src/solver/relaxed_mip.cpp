@@ -1,25 +1,22 @@
 #include <solver/relaxed_mip.hpp>
+#include <solver/relaxed_mip_model.hpp>
 #include <problem.hpp>
+#include <stats.hpp>
+#include <trace.hpp>
 #include <gurobi_c++.h>
 #include <iostream>
+#include <stdexcept>
 
 
-std::tuple<mpp::solution_t, mpp::objective_t, mpp::risk_metric_t, mpp::constraints_t>
-mpp::solver::relaxed_mip(const ::mpp::problem_t& problem, long long int timelimit, int threads, bool verbose) {
-
-    // Create and configure a Gurobi environment
-    GRBEnv env = GRBEnv(true);
-    env.set(GRB_IntParam_OutputFlag, 0);
-    env.start();
+mpp::solver::mip_variables_t
+mpp::solver::build_relaxed_mip_model(GRBModel& model, const ::mpp::problem_t& problem) {
 
-    // Create a Gurobi model
-    GRBModel model(env);
+    stats::scoped_timer_t timer(stats::phase_t::mip_build);
+    trace::span_t span("mip_build");
 
     // Get the data from the problem
     const auto& data = problem.get_data();
-    const auto& intervention_names = problem.get_intervention_names();
     const auto& interventions = data[mpp::params::INTERVENTIONS];
-    const auto& resources = data[mpp::params::RESOURCES];
     const auto& exclusions = data[mpp::params::EXCLUSIONS];
     const auto& scenarios_number = data[mpp::params::SCENARIOS_NUMBER];
     const auto& seasons = data[mpp::params::SEASONS];
@@ -27,28 +24,27 @@ mpp::solver::relaxed_mip(const ::mpp::problem_t& problem, long long int timelimi
     double quantile = data[mpp::params::QUANTILE].template get<double>();
     double alpha = data[mpp::params::ALPHA].template get<double>();
 
-    // Create variables for each pair intervention/time
-    std::map< std::string, std::map<int, GRBVar> > x;
-    for (const auto& [intervention_name, intervention_data] : interventions.items()) {
-        int t_max = intervention_data[mpp::params::INTERVENTION_TMAX].template get<int>();
-        for (int t = 1; t <= t_max; ++t) {
-            x[intervention_name].insert({t, model.addVar(0.0, 1.0, 0.0, GRB_BINARY)});
+    // Create variables for each pair intervention/time (only for the allowed start times)
+    mip_variables_t x;
+    const auto& intervention_names = problem.get_intervention_names();
+    for (size_t i = 0; i < intervention_names.size(); ++i) {
+        for (int t : problem.get_allowed_starts(i)) {
+            x[intervention_names[i]].insert({t, model.addVar(0.0, 1.0, 0.0, GRB_BINARY)});
         }
     }
 
     // Set the objective function (14)
     GRBLinExpr obj = 0;
     for (const auto& [intervention_name, intervention_data] : interventions.items()) {
-        int t_max = intervention_data[mpp::params::INTERVENTION_TMAX].template get<int>();
         const auto& intervention_risk = intervention_data[mpp::params::INTERVENTION_RISK];
         for (int t = 1; t <= T; ++t) {
             const auto& risk_at_period = intervention_risk.find(std::to_string(t));
             if (risk_at_period != intervention_risk.end()) {
-                for (int ts = 1; ts <= t_max; ++ts) {
+                for (const auto& [ts, x_ts] : x[intervention_name]) {
                     const auto& risk = risk_at_period->find(std::to_string(ts));
                     if (risk != risk_at_period->end()) {
                         for (const auto& r : *risk) {
-                            obj += (r.template get<double>() / (T * risk->size())) * x[intervention_name][ts];
+                            obj += (r.template get<double>() / (T * risk->size())) * x_ts;
                         }
                     }
                 }
@@ -60,35 +56,35 @@ mpp::solver::relaxed_mip(const ::mpp::problem_t& problem, long long int timelimi
 
     // Add constraints (2)
     for (const auto& [intervention_name, intervention_data] : interventions.items()) {
-        int t_max = intervention_data[mpp::params::INTERVENTION_TMAX].template get<int>();
         GRBLinExpr expr = 0;
-        for (int t = 1; t <= t_max; ++t) {
-            expr += x[intervention_name][t];
+        for (const auto& [t, x_t] : x[intervention_name]) {
+            expr += x_t;
         }
         model.addConstr(expr == 1);
     }
 
-    // Add constraints (3) and (4)
-    for (const auto& [resource_name, resource_data] : resources.items()) {
+    // Add constraints (3) and (4) (the bounds are the ones of the compiled data, which may have been changed),
+    // from the contributors of each resource and period (the start times without a variable are not allowed)
+    std::vector< std::vector<const GRBVar*> > x_by_start(intervention_names.size());
+    for (size_t i = 0; i < intervention_names.size(); ++i) {
+        x_by_start[i].assign(problem.get_tmax(i), nullptr);
+        for (const auto& [ts, x_ts] : x[intervention_names[i]]) {
+            x_by_start[i][ts - 1] = &x_ts;
+        }
+    }
+
+    const auto& resource_names = problem.get_resource_names();
+    for (size_t r = 0; r < resource_names.size(); ++r) {
         for (int t = 1; t <= T; ++t) {
             GRBLinExpr expr = 0;
-            for (const auto& [intervention_name, intervention_data] : interventions.items()) {
-                int t_max = intervention_data[mpp::params::INTERVENTION_TMAX].template get<int>();
-                for (int ts = 1; ts <= t_max; ++ts) {
-                    const auto& intervention_workload = intervention_data[mpp::params::INTERVENTION_RESOURCE_WORKLOAD].find(resource_name);
-                    if (intervention_workload != intervention_data[mpp::params::INTERVENTION_RESOURCE_WORKLOAD].end()) {
-                        const auto& workload_at_period = intervention_workload->find(std::to_string(t));
-                        if (workload_at_period != intervention_workload->end()) {
-                            const auto& workload = workload_at_period->find(std::to_string(ts));
-                            if (workload != workload_at_period->end()) {
-                                expr += workload->template get<double>() * x[intervention_name][ts];
-                            }
-                        }
-                    }
+            for (const auto& contributor : problem.get_contributors(r, t - 1)) {
+                const GRBVar* x_ts = x_by_start[contributor.intervention][contributor.start_time - 1];
+                if (x_ts != nullptr) {
+                    expr += contributor.amount * (*x_ts);
                 }
             }
-            model.addConstr(expr <= resource_data[mpp::params::RESOURCE_UPPER_BOUND][t - 1].template get<double>()); // Constraint (3)
-            model.addConstr(expr >= resource_data[mpp::params::RESOURCE_LOWER_BOUND][t - 1].template get<double>()); // Constraint (4)
+            model.addConstr(expr <= problem.get_resource_upper_bound(r)[t - 1]); // Constraint (3)
+            model.addConstr(expr >= problem.get_resource_lower_bound(r)[t - 1]); // Constraint (4)
         }
     }
 
@@ -99,21 +95,19 @@ mpp::solver::relaxed_mip(const ::mpp::problem_t& problem, long long int timelimi
         const auto& season = seasons[exclusion_data[2].template get<std::string>()];
         const auto& intervention_1 = interventions[intervention_1_name];
         const auto& intervention_2 = interventions[intervention_2_name];
-        int t_max_1 = intervention_1[mpp::params::INTERVENTION_TMAX].template get<int>();
-        int t_max_2 = intervention_2[mpp::params::INTERVENTION_TMAX].template get<int>();
 
         for (const auto& t : season) {
             GRBLinExpr expr = 0;
 
-            for (int ts = 1; ts <= t_max_1; ++ts) {
+            for (const auto& [ts, x_ts] : x[intervention_1_name]) {
                 if (t >= ts && t <= ts + intervention_1[mpp::params::INTERVENTION_DELTA][ts - 1].template get<int>() - 1) {
-                    expr += x[intervention_1_name][ts];
+                    expr += x_ts;
                 }
             }
 
-            for (int ts = 1; ts <= t_max_2; ++ts) {
+            for (const auto& [ts, x_ts] : x[intervention_2_name]) {
                 if (t >= ts && t <= ts + intervention_2[mpp::params::INTERVENTION_DELTA][ts - 1].template get<int>() - 1) {
-                    expr += x[intervention_2_name][ts];
+                    expr += x_ts;
                 }
             }
 
@@ -121,9 +115,14 @@ mpp::solver::relaxed_mip(const ::mpp::problem_t& problem, long long int timelimi
         }
     }
 
-    // Optimize the model
+    return x;
+}
+
+
+void
+mpp::solver::configure_relaxed_mip_model(GRBModel& model, double timelimit, int threads, bool verbose) {
     model.set(GRB_IntParam_OutputFlag, (verbose ? 1 : 0));
-    model.set(GRB_DoubleParam_TimeLimit, (timelimit > 0 ? static_cast<double>(timelimit) : GRB_INFINITY));
+    model.set(GRB_DoubleParam_TimeLimit, (timelimit >= 0 ? timelimit : GRB_INFINITY));
 	model.set(GRB_IntParam_Threads, threads);
     model.set(GRB_DoubleParam_MIPGap, 1E-5);
     model.set(GRB_IntParam_MIPFocus, 1);    // Focus on finding feasible solutions
@@ -131,20 +130,45 @@ mpp::solver::relaxed_mip(const ::mpp::problem_t& problem, long long int timelimi
     model.set(GRB_IntParam_PrePasses, 1);   // Limit the number of pre-solve passes
     model.set(GRB_IntParam_Method, 1);      // Use the dual simplex method
     model.set(GRB_IntParam_Seed, 0);        // Use default seed 0
-    
-    model.optimize();
+}
+
+
+std::tuple<mpp::solution_t, mpp::objective_t, mpp::risk_metric_t, mpp::constraints_t>
+mpp::solver::relaxed_mip(const ::mpp::problem_t& problem, double timelimit, int threads, bool verbose,
+                         const std::vector< std::vector<int> >& starts, const cancellation_token_t& cancellation,
+                         double* bound) {
+
+    // Create a context with the Gurobi environment and the model, and solve it once
+    mip_context_t context(problem, threads, verbose);
+    context.set_cancellation(cancellation);
+    return relaxed_mip(context, timelimit, starts, bound);
+}
+
+
+std::tuple<mpp::solution_t, mpp::objective_t, mpp::risk_metric_t, mpp::constraints_t>
+mpp::solver::relaxed_mip(mip_context_t& context, double timelimit, const std::vector< std::vector<int> >& starts,
+                         double* bound) {
+
+    // Set the MIP starts, so the branch-and-bound can prune against them from the beginning
+    if (!starts.empty()) {
+        context.set_starts(starts);
+    }
+
+    // Optimize the model
+    const bool found = context.solve(timelimit);
+    if (bound != nullptr) *bound = context.get_bound();
+    if (!found) {
+        throw std::runtime_error("The relaxed MIP did not find a feasible solution.");
+    }
 
     // Extract the solution
+    const auto& problem = context.get_problem();
+    const auto& intervention_names = problem.get_intervention_names();
+    const std::vector<int> start_time = context.get_solution();
+
     mpp::solution_t solution;
-    for (const auto& intervention_name : intervention_names) {
-        const auto& intervention_data = interventions[intervention_name];
-        int t_max = intervention_data[mpp::params::INTERVENTION_TMAX].template get<int>();
-        for (int t = 1; t <= t_max; ++t) {
-            if (x[intervention_name][t].get(GRB_DoubleAttr_X) > 0.5) {
-                solution[intervention_name] = t;
-                break;
-            }
-        }
+    for (size_t i = 0; i < intervention_names.size(); ++i) {
+        solution[intervention_names[i]] = start_time[i];
     }
 
     auto [objective_value, risk_metric_value, constraints_value] = problem.evaluate(solution);
@@ -2,14 +2,42 @@
 #define INCLUDE_MPP_SOLVER_RELAXED_MIP_HPP_
 
 #include <tuple>
+#include <vector>
 #include <problem.hpp>
+#include <solver/mip_context.hpp>
 
 
 namespace mpp {
     namespace solver{
 
+        /**
+         * @brief Solve the relaxed MIP model of the maintenance planning problem.
+         * @param problem The maintenance planning problem instance.
+         * @param timelimit Limits the runtime of the MIP solver in seconds (-1 for no limit).
+         * @param threads Number of threads used by Gurobi.
+         * @param verbose Enable the Gurobi log.
+         * @param starts Start times of the interventions used as MIP starts, one vector per start (optional).
+         * @param cancellation Interrupts the solve when cancelled (the best solution found so far is returned).
+         * @param bound Set to the best bound on the objective of the model, i.e., on the mean risk of the feasible
+         * solutions (optional, see mip_context_t::get_bound). It is set even if no solution is found.
+         * @return A tuple containing the solution, objective value, risk metric, and constraints.
+         */
         std::tuple<solution_t, objective_t, risk_metric_t, constraints_t>
-        relaxed_mip(const problem_t& problem, long long int timelimit=-1, int threads=1, bool verbose=false);
+        relaxed_mip(const problem_t& problem, double timelimit=-1, int threads=1, bool verbose=false,
+            const std::vector< std::vector<int> >& starts = {},
+            const cancellation_token_t& cancellation = cancellation_token_t(), double* bound = nullptr);
+
+        /**
+         * @brief Solve the relaxed MIP model held by a persistent context.
+         * @param context The MIP context (with its current fixings and cuts).
+         * @param timelimit Limits the runtime of the MIP solver in seconds (-1 for no limit).
+         * @param starts Start times of the interventions used as MIP starts, one vector per start (optional).
+         * @param bound Set to the best bound on the objective of the model (optional, see mip_context_t::get_bound).
+         * @return A tuple containing the solution, objective value, risk metric, and constraints.
+         */
+        std::tuple<solution_t, objective_t, risk_metric_t, constraints_t>
+        relaxed_mip(mip_context_t& context, double timelimit=-1,
+            const std::vector< std::vector<int> >& starts = {}, double* bound = nullptr);
 
     }
 }
@@ -0,0 +1,45 @@
+#ifndef INCLUDE_MPP_SOLVER_RELAXED_MIP_MODEL_HPP_
+#define INCLUDE_MPP_SOLVER_RELAXED_MIP_MODEL_HPP_
+
+#include <map>
+#include <string>
+#include <gurobi_c++.h>
+#include <problem.hpp>
+
+
+namespace mpp {
+    namespace solver {
+
+        /**
+         * @brief Binary variables of the relaxed MIP, indexed by intervention name and start time.
+         */
+        using mip_variables_t = std::map< std::string, std::map<int, GRBVar> >;
+
+
+        /**
+         * @brief Build the relaxed MIP model of the maintenance planning problem.
+         * @details Adds the assignment variables, the mean risk objective, the assignment constraints,
+         * the resource constraints and the exclusion constraints to the given (empty) model.
+         * @param model The Gurobi model to populate.
+         * @param problem The maintenance planning problem instance.
+         * @return The assignment variables of the model.
+         */
+        mip_variables_t
+        build_relaxed_mip_model(GRBModel& model, const problem_t& problem);
+
+
+        /**
+         * @brief Set the Gurobi parameters used to solve the relaxed MIP.
+         * @param model The Gurobi model.
+         * @param timelimit Limits the runtime in seconds (-1 for no limit; 0 stops the solve at once).
+         * @param threads Number of threads used by Gurobi.
+         * @param verbose Enable the Gurobi log.
+         */
+        void
+        configure_relaxed_mip_model(GRBModel& model, double timelimit, int threads, bool verbose);
+
+    }
+}
+
+
+#endif // INCLUDE_MPP_SOLVER_RELAXED_MIP_MODEL_HPP_
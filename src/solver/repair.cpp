@@ -0,0 +1,133 @@
+#include <solver/repair.hpp>
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+
+mpp::solver::repair_t::repair_t(const mpp::problem_t& problem) : problem_(problem) {
+    const int T = problem.get_T();
+
+    // Resource bounds, flattened
+    const size_t n_resources = problem.get_resource_names().size();
+    upper_bound_.resize(n_resources * T);
+    lower_bound_.resize(n_resources * T);
+    for (size_t r = 0; r < n_resources; ++r) {
+        std::copy_n(problem.get_resource_upper_bound(r).begin(), T, upper_bound_.begin() + r * T);
+        std::copy_n(problem.get_resource_lower_bound(r).begin(), T, lower_bound_.begin() + r * T);
+    }
+}
+
+
+bool
+mpp::solver::repair_t::repair(std::vector<int>& start_time, long long int budget, const repair_cost_t& cost, std::mt19937* rng) const {
+    constexpr double tolerance = 1e-5;
+    constexpr int passes = 5;
+    const size_t n = start_time.size();
+    const int T = problem_.get_T();
+    const size_t n_resource_periods = upper_bound_.size();
+
+    auto tie_cost = [&](size_t i, int s) {
+        return cost ? cost(i, s) : problem_.get_mean_risk(i, s);
+    };
+
+    // Position of each start time among the allowed ones, usage of the resources and number of
+    // active interventions of each exclusion period
+    std::vector<size_t> position(n);
+    for (size_t i = 0; i < n; ++i) {
+        const auto& allowed_starts = problem_.get_allowed_starts(i);
+        auto it = std::lower_bound(allowed_starts.begin(), allowed_starts.end(), start_time[i]);
+        if (it == allowed_starts.end()) --it;
+        position[i] = static_cast<size_t>(it - allowed_starts.begin());
+    }
+
+    std::vector<double> usage(n_resource_periods, 0.0);
+    std::vector<int> active(problem_.get_exclusion_periods(), 0);
+    auto apply = [&](size_t i, size_t k, int sign) {
+        for (const auto& workload : problem_.get_workload(i, problem_.get_allowed_starts(i)[k])) {
+            usage[static_cast<size_t>(workload.resource) * T + workload.period] += sign * workload.amount;
+        }
+        problem_.for_each_exclusion_period(i, problem_.get_allowed_starts(i)[k], [&](size_t e) { active[e] += sign; });
+    };
+    for (size_t i = 0; i < n; ++i) apply(i, position[i], 1);
+
+    // Violation (count, amount) of the bounds of a resource at a period for a given usage
+    auto violation = [&](size_t rt, double u) -> std::pair<double, double> {
+        if (u > upper_bound_[rt] + tolerance) return { 1.0, u - upper_bound_[rt] };
+        if (u < lower_bound_[rt] - tolerance) return { 1.0, lower_bound_[rt] - u };
+        return { 0.0, 0.0 };
+    };
+
+    bool changed = false;
+    long long int work = 0;
+    for (int pass = 0; pass < passes; ++pass) {
+        bool violated = false;
+        bool underloaded = false;
+        for (size_t rt = 0; rt < n_resource_periods; ++rt) {
+            violated |= (violation(rt, usage[rt]).first > 0.0);
+            underloaded |= (usage[rt] < lower_bound_[rt] - tolerance);
+        }
+        for (size_t e = 0; e < active.size() && !violated; ++e) {
+            violated |= (active[e] > 1);
+        }
+        if (!violated) break;
+
+        bool moved = false;
+        const size_t first = (rng != nullptr && n > 0) ? (*rng)() % n : 0;
+        for (size_t c = 0; c < n; ++c) {
+            const size_t i = (first + c) % n;
+            const auto& allowed_starts = problem_.get_allowed_starts(i);
+            bool involved = underloaded;
+            for (const auto& workload : problem_.get_workload(i, allowed_starts[position[i]])) {
+                const size_t rt = static_cast<size_t>(workload.resource) * T + workload.period;
+                involved |= (violation(rt, usage[rt]).first > 0.0);
+            }
+            problem_.for_each_exclusion_period(i, allowed_starts[position[i]], [&](size_t e) { involved |= (active[e] > 1); });
+            if (!involved) continue;
+
+            // Stop when the budget does not allow evaluating all start times of the intervention
+            work += static_cast<long long int>(allowed_starts.size());
+            if (work > budget) {
+                pass = passes;
+                break;
+            }
+
+            // Remove the intervention and insert it back at its best start time
+            apply(i, position[i], -1);
+            auto insertion_cost = [&](size_t k) {
+                double count = 0.0;
+                double amount = 0.0;
+                for (const auto& workload : problem_.get_workload(i, allowed_starts[k])) {
+                    const size_t rt = static_cast<size_t>(workload.resource) * T + workload.period;
+                    const auto [count_before, amount_before] = violation(rt, usage[rt]);
+                    const auto [count_after, amount_after] = violation(rt, usage[rt] + workload.amount);
+                    count += count_after - count_before;
+                    amount += amount_after - amount_before;
+                }
+                problem_.for_each_exclusion_period(i, allowed_starts[k], [&](size_t e) { count += (active[e] > 0) ? 1.0 : 0.0; });
+                return std::make_tuple(count, amount, tie_cost(i, allowed_starts[k]));
+            };
+
+            size_t best = position[i];
+            auto best_cost = insertion_cost(best);
+            for (size_t k = 0; k < allowed_starts.size(); ++k) {
+                if (k == best) continue;
+                auto candidate_cost = insertion_cost(k);
+                if (candidate_cost < best_cost) {
+                    best_cost = candidate_cost;
+                    best = k;
+                }
+            }
+            moved |= (best != position[i]);
+            position[i] = best;
+            apply(i, position[i], 1);
+        }
+        if (!moved) break;
+        changed = true;
+    }
+
+    if (changed) {
+        for (size_t i = 0; i < n; ++i) start_time[i] = problem_.get_allowed_starts(i)[position[i]];
+    }
+    return changed;
+}
+
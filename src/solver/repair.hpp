@@ -0,0 +1,63 @@
+#ifndef INCLUDE_MPP_SOLVER_REPAIR_HPP_
+#define INCLUDE_MPP_SOLVER_REPAIR_HPP_
+
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+#include <problem.hpp>
+
+
+namespace mpp {
+    namespace solver {
+
+        /**
+         * @brief Cost used to break ties between start times of an intervention that are equally good for
+         * the constraints (e.g., its mean risk or a Lagrangian reduced cost). Lower is better.
+         */
+        using repair_cost_t = std::function<double(size_t intervention, int start_time)>;
+
+
+        /**
+         * @brief Resource- and exclusion-aware repair of schedules.
+         * @details Greedily moves the interventions involved in violations (all of them, if a resource is
+         * underloaded) to the allowed start time that most reduces the number and then the amount of violations,
+         * ties broken by a cost. Each move only updates the usage of the resources and exclusion periods (see
+         * problem_t::for_each_exclusion_period) of the moved intervention, so a move costs the workload and
+         * exclusion periods of the start times evaluated. Moves never increase the violations. The repair is
+         * read-only and can be used by concurrent threads.
+         */
+        class repair_t {
+            public:
+
+            /**
+             * @brief Flatten the resource bounds (the exclusion periods are the ones of the problem).
+             * @param problem The maintenance planning problem instance (its allowed start times and resource
+             * bounds must not change afterwards).
+             */
+            explicit repair_t(const problem_t& problem);
+
+            /**
+             * @brief Repair a schedule in place.
+             * @param start_time Start time of each intervention (in the order of problem_t::get_intervention_names()).
+             * @param budget Maximum number of start times evaluated.
+             * @param cost Cost of the start times, to break ties (optional, the mean risk by default).
+             * @param rng Random number generator used to choose the first intervention visited (optional, the
+             * first intervention if null), so that a small budget is not always spent on the same interventions.
+             * @return True if the schedule was changed.
+             */
+            bool repair(std::vector<int>& start_time,
+                long long int budget = std::numeric_limits<long long int>::max(),
+                const repair_cost_t& cost = nullptr, std::mt19937* rng = nullptr) const;
+
+            private:
+            const problem_t& problem_;
+            std::vector<double> upper_bound_;   // Resource bounds (resource x period)
+            std::vector<double> lower_bound_;
+        };
+
+    } // namespace solver
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_SOLVER_REPAIR_HPP_
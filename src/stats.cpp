@@ -0,0 +1,148 @@
+#include <stats.hpp>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+    constexpr size_t n_counters = static_cast<size_t>(mpp::stats::counter_t::size);
+    constexpr size_t n_phases = static_cast<size_t>(mpp::stats::phase_t::size);
+
+    const std::array<std::string, n_counters> counter_names = {
+        "evaluations", "evaluation_cache_hits", "generations", "trials", "trial_improvements", "trial_repairs", "exact_rescores",
+        "incumbent_improvements", "mip_solves", "lns_runs", "lagrangian_iterations"
+    };
+
+    const std::array<std::string, n_phases> phase_names = {
+        "load", "compile", "presolve", "seed", "mip_build", "mip_solve", "mutation", "evaluation", "selection", "lns", "lagrangian"
+    };
+
+
+    /**
+     * @brief Counters and times of a thread.
+     * @details Only the owner thread writes them (so updates need no atomic read-modify-write);
+     * they are atomic so that they can be read by other threads.
+     */
+    struct thread_stats_t {
+        std::array<std::atomic<long long int>, n_counters> counters{};
+        std::array<std::atomic<long long int>, n_phases> phase_ns{};
+        std::array<std::atomic<long long int>, n_phases> phase_calls{};
+    };
+
+
+    /**
+     * @brief Blocks of all threads that recorded something (they are kept after their threads exit).
+     */
+    struct registry_t {
+        std::mutex mtx;
+        std::vector< std::unique_ptr<thread_stats_t> > blocks;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    };
+
+    registry_t& registry() {
+        static registry_t instance;
+        return instance;
+    }
+
+    thread_stats_t& local_stats() {
+        thread_local thread_stats_t* block = nullptr;
+        if (block == nullptr) {
+            auto& r = registry();
+            std::lock_guard<std::mutex> lock(r.mtx);
+            r.blocks.push_back(std::make_unique<thread_stats_t>());
+            block = r.blocks.back().get();
+        }
+        return *block;
+    }
+
+    inline void add(std::atomic<long long int>& value, long long int delta) {
+        value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+} // namespace
+
+
+void
+mpp::stats::count(counter_t counter, long long int value) {
+    add(local_stats().counters[static_cast<size_t>(counter)], value);
+}
+
+
+void
+mpp::stats::add_time(phase_t phase, std::chrono::steady_clock::duration elapsed) {
+    auto& stats = local_stats();
+    add(stats.phase_ns[static_cast<size_t>(phase)], std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    add(stats.phase_calls[static_cast<size_t>(phase)], 1);
+}
+
+
+void
+mpp::stats::reset() {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mtx);
+    for (auto& block : r.blocks) {
+        for (auto& value : block->counters) value = 0;
+        for (auto& value : block->phase_ns) value = 0;
+        for (auto& value : block->phase_calls) value = 0;
+    }
+    r.start = std::chrono::steady_clock::now();
+}
+
+
+nlohmann::json
+mpp::stats::report() {
+    std::array<long long int, n_counters> counters{};
+    std::array<long long int, n_phases> phase_ns{};
+    std::array<long long int, n_phases> phase_calls{};
+    size_t threads = 0;
+    double wall_time = 0.0;
+
+    // Aggregate the blocks of all threads
+    {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock(r.mtx);
+        for (const auto& block : r.blocks) {
+            for (size_t k = 0; k < n_counters; ++k) counters[k] += block->counters[k].load(std::memory_order_relaxed);
+            for (size_t k = 0; k < n_phases; ++k) phase_ns[k] += block->phase_ns[k].load(std::memory_order_relaxed);
+            for (size_t k = 0; k < n_phases; ++k) phase_calls[k] += block->phase_calls[k].load(std::memory_order_relaxed);
+        }
+        threads = r.blocks.size();
+        wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - r.start).count();
+    }
+
+    nlohmann::json result;
+    result["wall_time"] = wall_time;
+    result["threads"] = threads;
+
+    for (size_t k = 0; k < n_counters; ++k) {
+        result["counters"][counter_names[k]] = counters[k];
+    }
+
+    for (size_t k = 0; k < n_phases; ++k) {
+        result["phases"][phase_names[k]] = { {"seconds", phase_ns[k] * 1e-9}, {"calls", phase_calls[k]} };
+    }
+
+    auto ratio = [](double a, double b) { return (b > 0.0) ? a / b : 0.0; };
+    const auto value = [&](counter_t counter) { return static_cast<double>(counters[static_cast<size_t>(counter)]); };
+    result["rates"]["evaluations_per_second"] = ratio(value(counter_t::evaluations), wall_time);
+    result["rates"]["cache_hit_rate"] = ratio(value(counter_t::evaluation_cache_hits), value(counter_t::trials));
+    result["rates"]["improvement_rate"] = ratio(value(counter_t::trial_improvements), value(counter_t::trials));
+
+    return result;
+}
+
+
+void
+mpp::stats::save_report(const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        throw std::runtime_error("Error opening stats file " + filename + " for writing.");
+    }
+    out << report().dump(2) << std::endl;
+}
@@ -0,0 +1,99 @@
+#ifndef INCLUDE_MPP_STATS_HPP_
+#define INCLUDE_MPP_STATS_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <json.hpp>
+
+
+namespace mpp {
+    namespace stats {
+
+        /**
+         * @brief Event counters.
+         */
+        enum class counter_t : size_t {
+            evaluations,              // Solutions evaluated (problem_t::evaluate)
+            evaluation_cache_hits,    // DE trial vectors equal to their parent (not evaluated)
+            generations,              // DE generations
+            trials,                   // DE trial vectors generated
+            trial_improvements,       // DE trial vectors better than their parent
+            trial_repairs,            // DE trial vectors changed by the repair
+            exact_rescores,           // DE best solutions re-scored exactly (reduced-precision risks)
+            incumbent_improvements,   // Improvements of the best solution
+            mip_solves,               // MIP solves (relaxed MIP and LNS sub-MIPs)
+            lns_runs,                 // LNS runs
+            lagrangian_iterations,    // Subgradient iterations of the Lagrangian relaxation
+            size
+        };
+
+        /**
+         * @brief Phases whose time is measured.
+         */
+        enum class phase_t : size_t {
+            load,         // JSON parsing of the instance
+            compile,      // Compilation of the instance data
+            presolve,     // Start time domain presolve
+            seed,         // Seed solution of the DE (relaxed MIP or constructive heuristic)
+            mip_build,    // Construction of MIP models
+            mip_solve,    // MIP solves
+            mutation,     // DE mutation and crossover
+            evaluation,   // DE evaluation of trial vectors
+            selection,    // DE selection
+            lns,          // LNS runs
+            lagrangian,   // Lagrangian relaxation runs
+            size
+        };
+
+        /**
+         * @brief Add to a counter of the calling thread.
+         */
+        void count(counter_t counter, long long int value = 1);
+
+        /**
+         * @brief Add the time of a call of a phase to the calling thread.
+         */
+        void add_time(phase_t phase, std::chrono::steady_clock::duration elapsed);
+
+        /**
+         * @brief Measure the time of a phase until the end of the scope.
+         */
+        class scoped_timer_t {
+            public:
+            explicit scoped_timer_t(phase_t phase) : phase_(phase), start_(std::chrono::steady_clock::now()) { }
+            ~scoped_timer_t() { add_time(phase_, std::chrono::steady_clock::now() - start_); }
+
+            scoped_timer_t(const scoped_timer_t&) = delete;
+            scoped_timer_t& operator=(const scoped_timer_t&) = delete;
+
+            private:
+            phase_t phase_;
+            std::chrono::steady_clock::time_point start_;
+        };
+
+        /**
+         * @brief Clear the counters and times of all threads and restart the wall clock.
+         */
+        void reset();
+
+        /**
+         * @brief Counters and times aggregated over all threads.
+         * @details Times are summed over threads, so phases running in parallel may add up to more
+         * than the wall time. Rates: evaluations per second (of wall time), cache hit rate (cache
+         * hits per trial) and improvement rate (trials better than their parent per trial).
+         * @return The report as a JSON object.
+         */
+        nlohmann::json report();
+
+        /**
+         * @brief Write the report (see report) to a JSON file.
+         * @param filename Path to the output file.
+         */
+        void save_report(const std::string& filename);
+
+    } // namespace stats
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_STATS_HPP_
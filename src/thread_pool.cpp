@@ -0,0 +1,104 @@
+#include <thread_pool.hpp>
+#include <trace.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+
+mpp::thread_pool_t::thread_pool_t(size_t threads) {
+    threads = std::max<size_t>(1, threads);
+    for (size_t k = 0; k < threads; ++k) {
+        workers_.emplace_back([this]() {
+            while (true) {
+                std::packaged_task<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mtx_);
+                    cv_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+                    if (stop_ && tasks_.empty()) return;
+                    task = std::move(tasks_.front());
+                    tasks_.pop();
+                }
+                task();
+            }
+        });
+    }
+}
+
+
+mpp::thread_pool_t::~thread_pool_t() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+
+size_t
+mpp::thread_pool_t::size() const {
+    return workers_.size();
+}
+
+
+std::future<void>
+mpp::thread_pool_t::submit(std::function<void()> task) {
+    std::packaged_task<void()> packaged(std::move(task));
+    std::future<void> future = packaged.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        tasks_.push(std::move(packaged));
+    }
+    cv_.notify_one();
+    return future;
+}
+
+
+void
+mpp::thread_pool_t::parallel_for(size_t n, const std::function<void(size_t)>& fn, size_t max_workers) {
+
+    // State shared with the helper tasks, which may start after the loop has finished
+    struct loop_t {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::exception_ptr error;
+    };
+
+    auto loop = std::make_shared<loop_t>();
+
+    // Take iterations until none is left
+    auto work = [loop, n, &fn]() {
+        mpp::trace::span_t span("parallel_for");
+        size_t i;
+        while ((i = loop->next.fetch_add(1)) < n) {
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(loop->mtx);
+                if (!loop->error) loop->error = std::current_exception();
+            }
+            if (loop->done.fetch_add(1) + 1 == n) {
+                std::lock_guard<std::mutex> lock(loop->mtx);
+                loop->cv.notify_all();
+            }
+        }
+    };
+
+    // The helpers only reference fn while there are iterations left, and the calling
+    // thread does not return before all iterations are done
+    const size_t helpers = std::min(std::max<size_t>(1, max_workers), n) - (n > 0 ? 1 : 0);
+    for (size_t k = 0; k < helpers; ++k) {
+        submit(work);
+    }
+
+    work();
+
+    mpp::trace::span_t span("parallel_for_wait");
+    std::unique_lock<std::mutex> lock(loop->mtx);
+    loop->cv.wait(lock, [&]() { return loop->done.load() == n; });
+    if (loop->error) std::rethrow_exception(loop->error);
+}
@@ -0,0 +1,71 @@
+#ifndef INCLUDE_MPP_THREAD_POOL_HPP_
+#define INCLUDE_MPP_THREAD_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+
+namespace mpp {
+
+    /**
+     * @brief Fixed-size pool of worker threads shared by all solvers of a process.
+     * @details Tasks are executed in FIFO order. Parallel loops (parallel_for) are executed by the calling
+     * thread together with up to (max_workers - 1) helper tasks queued in the pool, so they always make
+     * progress, even when all workers are busy (e.g., when called from a task running in the pool).
+     * The pool size is therefore a budget on the number of cores used by all the solvers sharing it.
+     */
+    class thread_pool_t {
+        public:
+
+        /**
+         * @brief Create the pool and start its worker threads.
+         * @param threads Number of worker threads (at least one).
+         */
+        explicit thread_pool_t(size_t threads);
+
+        /**
+         * @brief Wait for all queued tasks and stop the worker threads.
+         */
+        ~thread_pool_t();
+
+        thread_pool_t(const thread_pool_t&) = delete;
+        thread_pool_t& operator=(const thread_pool_t&) = delete;
+
+        /**
+         * @brief Number of worker threads.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Queue a task for execution.
+         * @return A future to wait for the task (and get its exceptions, if any).
+         */
+        std::future<void> submit(std::function<void()> task);
+
+        /**
+         * @brief Execute fn(0), ..., fn(n - 1) in parallel and wait for all of them.
+         * @param n Number of iterations.
+         * @param fn Function called for each iteration.
+         * @param max_workers Maximum number of threads (including the calling one) working on the loop.
+         */
+        void parallel_for(size_t n, const std::function<void(size_t)>& fn, size_t max_workers);
+
+        private:
+        std::vector<std::thread> workers_;
+        std::queue< std::packaged_task<void()> > tasks_;
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        bool stop_ = false;
+    };
+
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_THREAD_POOL_HPP_
@@ -0,0 +1,140 @@
+#include <trace.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+    /**
+     * @brief A span recorded by a thread.
+     */
+    struct event_t {
+        const char* name = nullptr;
+        std::chrono::steady_clock::time_point begin;
+        std::chrono::steady_clock::time_point end;
+    };
+
+
+    /**
+     * @brief Ring buffer of the spans of a thread.
+     * @details Only the owner thread writes it: an event is written before the head is published
+     * (release), so a reader that acquires the head sees complete events.
+     */
+    struct thread_buffer_t {
+        size_t tid = 0;
+        std::vector<event_t> events;
+        std::atomic<size_t> head{0};
+    };
+
+
+    /**
+     * @brief Buffers of all threads that recorded spans (they are kept after their threads exit).
+     */
+    struct registry_t {
+        std::mutex mtx;
+        std::vector< std::unique_ptr<thread_buffer_t> > buffers;
+        std::atomic<bool> enabled{false};
+        size_t capacity = 0;
+        std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    };
+
+    registry_t& registry() {
+        static registry_t instance;
+        return instance;
+    }
+
+    thread_buffer_t& local_buffer() {
+        thread_local thread_buffer_t* buffer = nullptr;
+        if (buffer == nullptr) {
+            auto& r = registry();
+            std::lock_guard<std::mutex> lock(r.mtx);
+            r.buffers.push_back(std::make_unique<thread_buffer_t>());
+            buffer = r.buffers.back().get();
+            buffer->tid = r.buffers.size();
+            buffer->events.resize(std::max<size_t>(1, r.capacity));
+        }
+        return *buffer;
+    }
+
+} // namespace
+
+
+void
+mpp::trace::start(size_t capacity) {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mtx);
+    r.capacity = std::max<size_t>(1, capacity);
+    for (auto& buffer : r.buffers) {
+        buffer->events.assign(r.capacity, event_t());
+        buffer->head.store(0, std::memory_order_relaxed);
+    }
+    r.epoch = std::chrono::steady_clock::now();
+    r.enabled.store(true, std::memory_order_release);
+}
+
+
+void
+mpp::trace::stop() {
+    registry().enabled.store(false, std::memory_order_release);
+}
+
+
+bool
+mpp::trace::enabled() {
+    return registry().enabled.load(std::memory_order_relaxed);
+}
+
+
+void
+mpp::trace::record(const char* name, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+    auto& buffer = local_buffer();
+    const size_t head = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[head % buffer.events.size()] = {name, begin, end};
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+
+void
+mpp::trace::save(const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        throw std::runtime_error("Error opening trace file " + filename + " for writing.");
+    }
+
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mtx);
+    auto microseconds = [&](std::chrono::steady_clock::time_point t) {
+        return std::chrono::duration<double, std::micro>(t - r.epoch).count();
+    };
+
+    // One complete ("X") event per span, and the name of each track
+    char buffer[64];
+    bool first = true;
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    for (const auto& thread_buffer : r.buffers) {
+        out << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread_buffer->tid
+            << ", \"args\": {\"name\": \"thread " << thread_buffer->tid << "\"}}";
+        first = false;
+
+        const size_t head = thread_buffer->head.load(std::memory_order_acquire);
+        const size_t capacity = thread_buffer->events.size();
+        for (size_t k = (head > capacity ? head - capacity : 0); k < head; ++k) {
+            const event_t& event = thread_buffer->events[k % capacity];
+            if (event.begin < r.epoch) continue;
+            std::snprintf(buffer, sizeof(buffer), "\"ts\": %.3f, \"dur\": %.3f", microseconds(event.begin), microseconds(event.end) - microseconds(event.begin));
+            out << ",\n{\"name\": \"" << event.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << thread_buffer->tid << ", " << buffer << "}";
+        }
+    }
+    out << "\n]}\n";
+
+    if (out.fail()) {
+        throw std::runtime_error("Error writing trace file " + filename + ".");
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef INCLUDE_MPP_TRACE_HPP_
+#define INCLUDE_MPP_TRACE_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+
+namespace mpp {
+    namespace trace {
+
+        /**
+         * @brief Start recording spans (and discard the ones recorded before).
+         * @details Each thread records its spans in its own ring buffer, so recording needs no lock
+         * and no atomic read-modify-write. When a buffer is full, the oldest spans of the thread are
+         * overwritten.
+         * @param capacity Number of spans kept per thread.
+         */
+        void start(size_t capacity = 1 << 18);
+
+        /**
+         * @brief Stop recording spans (the spans recorded are kept until the next start).
+         */
+        void stop();
+
+        /**
+         * @brief Check whether spans are being recorded.
+         */
+        bool enabled();
+
+        /**
+         * @brief Record a span of the calling thread.
+         * @param name Name of the span (must outlive the trace, e.g. a string literal).
+         * @param begin Start time of the span.
+         * @param end End time of the span.
+         */
+        void record(const char* name, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end);
+
+        /**
+         * @brief Record a span from its construction until the end of the scope (nothing is done when
+         * the trace is not enabled).
+         */
+        class span_t {
+            public:
+            explicit span_t(const char* name) : name_(enabled() ? name : nullptr) {
+                if (name_ != nullptr) start_ = std::chrono::steady_clock::now();
+            }
+            ~span_t() {
+                if (name_ != nullptr) record(name_, start_, std::chrono::steady_clock::now());
+            }
+
+            span_t(const span_t&) = delete;
+            span_t& operator=(const span_t&) = delete;
+
+            private:
+            const char* name_;
+            std::chrono::steady_clock::time_point start_;
+        };
+
+        /**
+         * @brief Write the spans recorded in the Chrome Trace Event format (viewable in Perfetto or
+         * chrome://tracing), one track per thread.
+         * @details Must be called when no thread is recording spans (e.g. after the solver returns).
+         * @param filename Path to the output file.
+         */
+        void save(const std::string& filename);
+
+    } // namespace trace
+} // namespace mpp
+
+
+#endif // INCLUDE_MPP_TRACE_HPP_
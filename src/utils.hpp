@@ -3,6 +3,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 
 namespace mpp {
@@ -12,6 +13,13 @@ namespace mpp {
             return std::max(lb, std::min(ub, static_cast<int>(value + 0.5)));
         }
 
+        inline int nearest_allowed(int value, const std::vector<int>& allowed) {
+            auto it = std::lower_bound(allowed.begin(), allowed.end(), value);
+            if (it == allowed.end()) return allowed.back();
+            if (it == allowed.begin() || *it == value) return *it;
+            return (*it - value <= value - *(it - 1)) ? *it : *(it - 1);
+        }
+
         inline int compare(double a, double b, double eps = 1E-6) {
             if (std::fabs(a - b) < eps) return 0;
             return (a < b) ? -1 : 1;
@@ -0,0 +1,60 @@
+#include <generator.hpp>
+#include <problem.hpp>
+#include <solver/checkpoint.hpp>
+#include <solver/differential_evolution.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+
+int main() {
+
+    // A small generated instance
+    mpp::generator_settings_t instance_settings;
+    instance_settings.T = 40;
+    instance_settings.interventions = 30;
+    instance_settings.seed = 4;
+    std::stringstream instance;
+    mpp::generate_instance(instance_settings, instance);
+    const mpp::problem_t problem(mpp::json::parse(instance));
+
+    const auto directory = std::filesystem::temp_directory_path();
+    const std::string first_checkpoint = (directory / "mpp_checkpoint_test_1.bin").string();
+    const std::string second_checkpoint = (directory / "mpp_checkpoint_test_2.bin").string();
+
+    mpp::solver::differential_evolution_settings_t settings;
+    settings.threads = 1;
+    settings.lns_stall = 0;
+    settings.verbose = false;
+
+    // A run of a few generations, whose checkpoint claims that its time limit is already used up
+    settings.max_generations = 5;
+    settings.checkpoint = first_checkpoint;
+    mpp::solver::differential_evolution(problem, settings);
+
+    mpp::solver::checkpoint_t checkpoint = mpp::solver::load_checkpoint(first_checkpoint);
+    checkpoint.elapsed = 100.0;
+    mpp::solver::save_checkpoint(checkpoint, first_checkpoint);
+
+    // Resumed with a smaller time limit and no other limit: the run must return at once, without any generation
+    settings.max_generations = -1;
+    settings.timelimit = 10;
+    settings.checkpoint = second_checkpoint;
+    settings.resume = first_checkpoint;
+    const auto start = std::chrono::steady_clock::now();
+    mpp::solver::differential_evolution(problem, settings);
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const mpp::solver::checkpoint_t resumed = mpp::solver::load_checkpoint(second_checkpoint);
+    std::remove(first_checkpoint.c_str());
+    std::remove(second_checkpoint.c_str());
+
+    std::cout << "Resumed run: " << resumed.generation - checkpoint.generation << " generations in "
+              << elapsed << " seconds." << std::endl;
+    const bool ok = (resumed.generation == checkpoint.generation && elapsed < settings.timelimit);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
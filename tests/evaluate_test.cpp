@@ -0,0 +1,207 @@
+#include <generator.hpp>
+#include <problem.hpp>
+#include <risk_table.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+namespace {
+
+    using mpp::json;
+    using evaluation_t = std::tuple<mpp::objective_t, mpp::risk_metric_t, mpp::constraints_t>;
+
+
+    /**
+     * @brief Reference evaluation of a schedule, straight from the instance data (the formulas of the
+     * challenge, as in the original evaluator: no compiled data, no exclusion index).
+     * @param data The instance data (as normalized by problem_t).
+     * @param solution Start time of each intervention.
+     */
+    evaluation_t reference_evaluate(const json& data, const mpp::solution_t& solution) {
+        constexpr double tolerance = 1e-5;
+        const int T = data[mpp::params::T].template get<int>();
+        const double quantile = data[mpp::params::QUANTILE].template get<double>();
+        const double alpha = data[mpp::params::ALPHA].template get<double>();
+        const json& interventions = data[mpp::params::INTERVENTIONS];
+        const json& resources = data[mpp::params::RESOURCES];
+        const json& scenarios_number = data[mpp::params::SCENARIOS_NUMBER];
+        const json& seasons = data[mpp::params::SEASONS];
+
+        std::vector<double> mean_risk_by_period(T, 0.0);
+        std::vector< std::vector<double> > risk;
+        for (int t = 0; t < T; ++t) risk.emplace_back(scenarios_number[t].template get<int>(), 0.0);
+        std::map< std::string, std::vector<double> > usage;
+        for (const auto& [resource_name, resource_data] : resources.items()) usage.emplace(resource_name, std::vector<double>(T, 0.0));
+
+        // Risks and workloads of the interventions over the periods they cover
+        for (const auto& [intervention_name, intervention_data] : interventions.items()) {
+            const int start_time = solution.at(intervention_name);
+            const int delta = intervention_data[mpp::params::INTERVENTION_DELTA][start_time - 1].template get<int>();
+            const std::string start_time_key = std::to_string(start_time);
+
+            for (int t = start_time - 1; t < start_time + delta - 1 && t < T; ++t) {
+                const std::string period_key = std::to_string(t + 1);
+                const json& intervention_risk = intervention_data[mpp::params::INTERVENTION_RISK];
+                if (intervention_risk.contains(period_key) && intervention_risk[period_key].contains(start_time_key)) {
+                    const json& scenario_risk = intervention_risk[period_key][start_time_key];
+                    for (size_t s = 0; s < scenario_risk.size(); ++s) {
+                        risk[t][s] += scenario_risk[s].template get<double>();
+                        mean_risk_by_period[t] += scenario_risk[s].template get<double>();
+                    }
+                }
+                for (const auto& [resource_name, workload] : intervention_data[mpp::params::INTERVENTION_RESOURCE_WORKLOAD].items()) {
+                    if (workload.contains(period_key) && workload[period_key].contains(start_time_key)) {
+                        usage[resource_name][t] += workload[period_key][start_time_key].template get<double>();
+                    }
+                }
+            }
+        }
+
+        // Resource bounds
+        double resource_count = 0.0;
+        double resource_sum = 0.0;
+        for (const auto& [resource_name, resource_data] : resources.items()) {
+            for (int t = 0; t < T; ++t) {
+                const double upper_bound = resource_data[mpp::params::RESOURCE_UPPER_BOUND][t].template get<double>();
+                const double lower_bound = resource_data[mpp::params::RESOURCE_LOWER_BOUND][t].template get<double>();
+                if (usage[resource_name][t] > upper_bound + tolerance) {
+                    resource_sum += usage[resource_name][t] - upper_bound;
+                    resource_count += 1.0;
+                }
+                if (usage[resource_name][t] < lower_bound - tolerance) {
+                    resource_sum += lower_bound - usage[resource_name][t];
+                    resource_count += 1.0;
+                }
+            }
+        }
+
+        // Exclusions: season periods in which both interventions are active
+        double exclusions = 0.0;
+        for (const auto& [exclusion_name, exclusion_data] : data[mpp::params::EXCLUSIONS].items()) {
+            int begin = 0;
+            int end = T + 1;
+            for (size_t k = 0; k < 2; ++k) {
+                const std::string intervention_name = exclusion_data[k].template get<std::string>();
+                const int start_time = solution.at(intervention_name);
+                const int delta = interventions[intervention_name][mpp::params::INTERVENTION_DELTA][start_time - 1].template get<int>();
+                begin = std::max(begin, start_time);
+                end = std::min(end, start_time + delta - 1);
+            }
+            for (const auto& t : seasons[exclusion_data[2].template get<std::string>()]) {
+                if (t.template get<int>() >= begin && t.template get<int>() <= end) exclusions += 1.0;
+            }
+        }
+
+        // Mean risk and expected excess
+        double mean_risk = 0.0;
+        double expected_excess = 0.0;
+        for (int t = 0; t < T; ++t) {
+            mean_risk_by_period[t] /= scenarios_number[t].template get<int>();
+            mean_risk += mean_risk_by_period[t];
+            const int quantile_idx = static_cast<int>(std::ceil(risk[t].size() * quantile) + 0.5) - 1;
+            std::nth_element(risk[t].begin(), risk[t].begin() + quantile_idx, risk[t].end());
+            expected_excess += std::max(risk[t][quantile_idx] - mean_risk_by_period[t], 0.0);
+        }
+        mean_risk /= T;
+        expected_excess /= T;
+
+        return { alpha * mean_risk + (1.0 - alpha) * expected_excess, {mean_risk, expected_excess}, {exclusions, resource_count, resource_sum} };
+    }
+
+
+    /**
+     * @brief Compare two values up to a relative tolerance, and report a mismatch.
+     */
+    bool close(const std::string& name, double value, double reference, double tolerance) {
+        if (std::fabs(value - reference) <= tolerance * std::max(1.0, std::fabs(reference))) return true;
+        std::cout << "\t" << name << ": " << value << " vs " << reference << " (reference)" << std::endl;
+        return false;
+    }
+
+} // namespace
+
+
+int main() {
+    constexpr int schedules = 50;
+
+    // Generated instances: varied durations (and durations past the horizon), scenarios, resource bounds
+    // (with lower bounds) and exclusions
+    std::vector<mpp::generator_settings_t> instances(3);
+    instances[0].T = 30;
+    instances[0].interventions = 20;
+    instances[0].exclusions = 15;
+    instances[0].resource_lower = 0.5;
+    instances[0].seed = 1;
+    instances[1].T = 70;
+    instances[1].interventions = 40;
+    instances[1].delta_max = 12;
+    instances[1].delta_variation = 3;
+    instances[1].scenarios_min = 1;
+    instances[1].scenarios_max = 5;
+    instances[1].seasons = 1;
+    instances[1].exclusions = 40;
+    instances[1].resource_tightness = 1.0;
+    instances[1].seed = 2;
+    instances[2].T = 130;
+    instances[2].interventions = 30;
+    instances[2].resources = 5;
+    instances[2].resource_density = 0.9;
+    instances[2].quantile = 0.5;
+    instances[2].alpha = 0.3;
+    instances[2].seed = 3;
+
+    int failures = 0;
+    for (size_t k = 0; k < instances.size(); ++k) {
+        std::stringstream instance;
+        mpp::generate_instance(instances[k], instance);
+        const mpp::problem_t problem(mpp::json::parse(instance));
+        const auto& intervention_names = problem.get_intervention_names();
+
+        // Evaluations compared with the reference (exact, and with the risk tables), with their tolerance
+        const mpp::risk_table_t float32_table(problem, mpp::risk_precision_t::float32);
+        const mpp::risk_table_t int16_table(problem, mpp::risk_precision_t::int16);
+        const std::vector< std::tuple<std::string, const mpp::risk_table_t*, double> > precisions = {
+            { "float64", nullptr, 1e-9 },
+            { "float32", &float32_table, 1e-5 },
+            { "int16", &int16_table, 1e-4 },
+        };
+
+        std::mt19937 rng(static_cast<unsigned int>(k));
+        for (int s = 0; s < schedules; ++s) {
+            std::vector<int> start_time(intervention_names.size());
+            mpp::solution_t solution;
+            for (size_t i = 0; i < intervention_names.size(); ++i) {
+                start_time[i] = 1 + static_cast<int>(rng() % static_cast<unsigned int>(problem.get_tmax(i)));
+                solution[intervention_names[i]] = start_time[i];
+            }
+            const auto [reference_objective, reference_risk, reference_constraints] = reference_evaluate(problem.get_data(), solution);
+
+            for (const auto& [precision, risk_table, tolerance] : precisions) {
+                const auto [objective, risk, constraints] = risk_table ? problem.evaluate(start_time, *risk_table) : problem.evaluate(start_time);
+
+                // The constraints do not depend on the precision of the risks
+                bool ok = close("objective", objective, reference_objective, tolerance);
+                ok &= close("mean risk", std::get<0>(risk), std::get<0>(reference_risk), tolerance);
+                ok &= close("expected excess", std::get<1>(risk), std::get<1>(reference_risk), tolerance);
+                ok &= close("exclusions", std::get<0>(constraints), std::get<0>(reference_constraints), 0.0);
+                ok &= close("resource count", std::get<1>(constraints), std::get<1>(reference_constraints), 0.0);
+                ok &= close("resource sum", std::get<2>(constraints), std::get<2>(reference_constraints), 1e-9);
+                if (!ok) {
+                    std::cout << "Mismatch on instance " << k << ", schedule " << s << ", precision " << precision << "." << std::endl;
+                    ++failures;
+                }
+            }
+        }
+    }
+
+    std::cout << failures << " mismatches." << std::endl;
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
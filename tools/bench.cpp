@@ -0,0 +1,379 @@
+#include <problem.hpp>
+#include <generator.hpp>
+#include <thread_pool.hpp>
+#include <solver/differential_evolution.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cxxopts.hpp>
+#include <cxxtimer.hpp>
+
+#ifdef MPP_WITH_GUROBI
+#include <gurobi_c++.h>
+#include <solver/relaxed_mip_model.hpp>
+#endif
+
+#ifndef MPP_BUILD_FLAVOR
+#define MPP_BUILD_FLAVOR "unknown"
+#endif
+
+
+// Count the allocations of the whole program (the benchmarks report the allocations per operation).
+// All the forms of the global allocation functions are replaced, so that each pair of new and delete
+// uses the same allocator (malloc, or its aligned version)
+static std::atomic<size_t> allocations{0};
+
+static void* count_allocation(std::size_t size, std::size_t alignment = 0) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    if (alignment <= alignof(std::max_align_t)) return std::malloc(size);
+    void* ptr = nullptr;
+    return (posix_memalign(&ptr, alignment, size) == 0) ? ptr : nullptr;
+}
+
+static void* count_allocation_or_throw(std::size_t size, std::size_t alignment = 0) {
+    if (void* ptr = count_allocation(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size) { return count_allocation_or_throw(size); }
+void* operator new[](std::size_t size) { return count_allocation_or_throw(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return count_allocation_or_throw(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return count_allocation_or_throw(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return count_allocation(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return count_allocation(size); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return count_allocation(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return count_allocation(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+
+namespace {
+
+    using mpp::json;
+
+
+    /**
+     * @brief Result of a benchmark.
+     */
+    struct bench_result_t {
+        std::string name;
+        std::string instance;
+        long long int iterations = 0;
+        double ns_per_op = 0.0;
+        double ops_per_second = 0.0;
+        double allocations_per_op = 0.0;
+    };
+
+
+    /**
+     * @brief Run an operation until min_time seconds are spent (doubling the number of iterations).
+     * @param ops_per_call Number of operations performed by each call (for the throughput).
+     */
+    template <typename F>
+    bench_result_t run_benchmark(const std::string& name, const std::string& instance, double min_time, double ops_per_call, F&& op) {
+        op();  // Warm up
+
+        long long int iterations = 1;
+        while (true) {
+            const size_t allocations_before = allocations.load();
+            cxxtimer::Timer timer(true);
+            for (long long int k = 0; k < iterations; ++k) {
+                op();
+            }
+            const double elapsed = timer.count<cxxtimer::ns>() * 1e-9;
+            const size_t allocations_after = allocations.load();
+
+            if (elapsed >= min_time || iterations >= (1LL << 40)) {
+                const double ops = iterations * ops_per_call;
+                bench_result_t result;
+                result.name = name;
+                result.instance = instance;
+                result.iterations = iterations;
+                result.ns_per_op = elapsed * 1e9 / ops;
+                result.ops_per_second = ops / elapsed;
+                result.allocations_per_op = (allocations_after - allocations_before) / ops;
+                return result;
+            }
+            iterations *= 2;
+        }
+    }
+
+
+    /**
+     * @brief Synthetic instance generated in memory.
+     */
+    mpp::problem_t synthetic_instance(int T, size_t n, int delta_max, int scenarios) {
+        mpp::generator_settings_t settings;
+        settings.T = T;
+        settings.interventions = n;
+        settings.delta_max = delta_max;
+        settings.scenarios_min = scenarios;
+        settings.scenarios_max = scenarios;
+
+        std::stringstream instance;
+        mpp::generate_instance(settings, instance);
+        return mpp::problem_t(json::parse(instance));
+    }
+
+
+    /**
+     * @brief Random solution (start times drawn from the allowed ones).
+     */
+    std::vector<int> random_solution(const mpp::problem_t& problem, std::mt19937& rng) {
+        std::vector<int> start_time(problem.get_intervention_names().size());
+        for (size_t i = 0; i < start_time.size(); ++i) {
+            const auto& allowed_starts = problem.get_allowed_starts(i);
+            start_time[i] = allowed_starts[rng() % allowed_starts.size()];
+        }
+        return start_time;
+    }
+
+
+    /**
+     * @brief Run all benchmarks on an instance.
+     */
+    void run_benchmarks(const mpp::problem_t& problem, const std::string& instance, double min_time,
+                        mpp::thread_pool_t& thread_pool, std::vector<bench_result_t>& results) {
+
+        std::mt19937 rng(0);
+        const size_t n = problem.get_intervention_names().size();
+        volatile double sink = 0.0;
+
+        // Full evaluation of a solution
+        {
+            const auto start_time = random_solution(problem, rng);
+            results.push_back(run_benchmark("evaluate", instance, min_time, 1.0, [&]() {
+                sink = std::get<0>(problem.evaluate(start_time));
+            }));
+        }
+
+        // Evaluation of a pool of solutions (in parallel, as in a DE generation)
+        {
+            const size_t pool_size = 36;
+            std::vector< std::vector<int> > pool;
+            for (size_t k = 0; k < pool_size; ++k) pool.push_back(random_solution(problem, rng));
+            std::vector<double> objectives(pool_size);
+            results.push_back(run_benchmark("evaluate_batch", instance, min_time, static_cast<double>(pool_size), [&]() {
+                thread_pool.parallel_for(pool_size, [&](size_t k) {
+                    objectives[k] = std::get<0>(problem.evaluate(pool[k]));
+                }, thread_pool.size());
+            }));
+        }
+
+        // Move of one intervention to another start time and evaluation of the new solution
+        {
+            auto start_time = random_solution(problem, rng);
+            results.push_back(run_benchmark("move_evaluate", instance, min_time, 1.0, [&]() {
+                const size_t i = rng() % n;
+                const auto& allowed_starts = problem.get_allowed_starts(i);
+                start_time[i] = allowed_starts[rng() % allowed_starts.size()];
+                sink = std::get<0>(problem.evaluate(start_time));
+            }));
+        }
+
+        // Quantile selection of the risk scenarios of a period (as in the evaluation)
+        {
+            const auto& scenarios_number = problem.get_data()[mpp::params::SCENARIOS_NUMBER];
+            const double quantile = problem.get_data()[mpp::params::QUANTILE].template get<double>();
+            const int scenarios = std::max_element(scenarios_number.begin(), scenarios_number.end())->template get<int>();
+            std::uniform_real_distribution<double> unif(0.0, 10.0);
+            std::vector<double> risk(scenarios);
+            for (auto& r : risk) r = unif(rng);
+            std::vector<double> buffer(risk);
+            const int quantile_idx = static_cast<int>(std::ceil(scenarios * quantile) + 0.5) - 1;
+            results.push_back(run_benchmark("quantile", instance, min_time, 1.0, [&]() {
+                std::copy(risk.begin(), risk.end(), buffer.begin());
+                std::nth_element(buffer.begin(), buffer.begin() + quantile_idx, buffer.end());
+                sink = buffer[quantile_idx];
+            }));
+        }
+
+        // DE generation (the setup of the run is excluded by the difference of two runs)
+        {
+            mpp::solver::differential_evolution_settings_t settings;
+            settings.timelimit = std::numeric_limits<long long int>::max();
+            settings.threads = static_cast<int>(thread_pool.size());
+            settings.thread_pool = &thread_pool;
+            settings.lns_stall = 0;
+            settings.verbose = false;
+
+            auto run_generations = [&](long long int generations, size_t& run_allocations) {
+                settings.max_generations = generations;
+                const size_t allocations_before = allocations.load();
+                cxxtimer::Timer timer(true);
+                mpp::solver::differential_evolution(problem, settings);
+                run_allocations = allocations.load() - allocations_before;
+                return timer.count<cxxtimer::ns>() * 1e-9;
+            };
+
+            const long long int base_generations = 2;
+            long long int generations = 4;
+            size_t base_allocations = 0;
+            size_t run_allocations = 0;
+            const double base_time = run_generations(base_generations, base_allocations);
+            double elapsed = run_generations(generations, run_allocations);
+            while (elapsed - base_time < min_time && generations < (1LL << 20)) {
+                generations *= 2;
+                elapsed = run_generations(generations, run_allocations);
+            }
+
+            const double ops = static_cast<double>(generations - base_generations);
+            bench_result_t result;
+            result.name = "de_generation";
+            result.instance = instance;
+            result.iterations = generations;
+            result.ns_per_op = std::max(0.0, elapsed - base_time) * 1e9 / ops;
+            result.ops_per_second = (result.ns_per_op > 0.0) ? 1e9 / result.ns_per_op : 0.0;
+            result.allocations_per_op = (static_cast<double>(run_allocations) - static_cast<double>(base_allocations)) / ops;
+            results.push_back(result);
+        }
+
+#ifdef MPP_WITH_GUROBI
+        // Construction of the relaxed MIP model
+        try {
+            GRBEnv env(true);
+            env.set(GRB_IntParam_OutputFlag, 0);
+            env.start();
+            results.push_back(run_benchmark("mip_build", instance, min_time, 1.0, [&]() {
+                GRBModel model(env);
+                mpp::solver::build_relaxed_mip_model(model, problem);
+                model.update();
+            }));
+        } catch (const GRBException& e) {
+            std::cerr << "Skipping mip_build: " << e.getMessage() << std::endl;
+        }
+#endif
+    }
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+
+    // Parse command line arguments using cxxopts
+    cxxopts::Options options("mpp_bench", "Micro-benchmarks of the hot paths of the maintenance planning problem solver.");
+    options.add_options()
+        ("instance", "Instance file to benchmark, in addition to the synthetic ones (can be given more than once).", cxxopts::value< std::vector<std::string> >())
+        ("synthetic", "Benchmark the synthetic instances.", cxxopts::value<bool>()->default_value("true"))
+        ("min_time", "Minimum time (in seconds) spent on each benchmark.", cxxopts::value<double>()->default_value("0.5"))
+        ("threads", "Number of threads used by the parallel benchmarks.", cxxopts::value<int>()->default_value(std::to_string(std::max(1u, std::thread::hardware_concurrency()))))
+        ("output", "Path to the output JSON file (standard output if not given).", cxxopts::value<std::string>())
+        ("baseline", "JSON file of a previous run (e.g., of another build): the speedup of each benchmark is reported.", cxxopts::value<std::string>())
+        ("h,help", "Show help message.");
+
+    try {
+
+        // Parse the command line arguments and show help if needed
+        auto result = options.parse(argc, argv);
+        if (result.count("help")) {
+            std::cout << options.help() << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        const double min_time = result["min_time"].as<double>();
+        const int threads = std::max(1, result["threads"].as<int>());
+        mpp::thread_pool_t thread_pool(threads);
+        std::vector<bench_result_t> results;
+
+        if (result["synthetic"].as<bool>()) {
+            run_benchmarks(synthetic_instance(30, 50, 3, 10), "synthetic_small", min_time, thread_pool, results);
+            run_benchmarks(synthetic_instance(100, 200, 5, 30), "synthetic_medium", min_time, thread_pool, results);
+        }
+
+        if (result.count("instance")) {
+            for (const auto& instance_file : result["instance"].as< std::vector<std::string> >()) {
+                run_benchmarks(mpp::problem_t(instance_file), instance_file, min_time, thread_pool, results);
+            }
+        }
+
+        // Report the results as JSON
+        json report;
+        report["build"] = MPP_BUILD_FLAVOR;
+        report["threads"] = threads;
+        report["min_time"] = min_time;
+        report["benchmarks"] = json::array();
+        for (const auto& r : results) {
+            report["benchmarks"].push_back({
+                {"name", r.name}, {"instance", r.instance}, {"iterations", r.iterations}, {"ns_per_op", r.ns_per_op},
+                {"ops_per_second", r.ops_per_second}, {"allocations_per_op", r.allocations_per_op}
+            });
+        }
+
+        // Speedup over a baseline run (matched by benchmark and instance)
+        if (result.count("baseline")) {
+            const std::string baseline_file = result["baseline"].as<std::string>();
+            std::ifstream baseline_in(baseline_file);
+            if (!baseline_in.is_open()) {
+                throw std::runtime_error("Error opening baseline file " + baseline_file + " for reading.");
+            }
+            const json baseline = json::parse(baseline_in);
+            report["baseline"] = baseline.value("build", baseline_file);
+
+            double log_sum = 0.0;
+            size_t compared = 0;
+            for (auto& benchmark : report["benchmarks"]) {
+                for (const auto& other : baseline["benchmarks"]) {
+                    if (other["name"] == benchmark["name"] && other["instance"] == benchmark["instance"]) {
+                        const double speedup = other["ns_per_op"].get<double>() / benchmark["ns_per_op"].get<double>();
+                        benchmark["speedup"] = speedup;
+                        log_sum += std::log(speedup);
+                        ++compared;
+                        std::cerr << std::left << std::setw(16) << benchmark["name"].get<std::string>() << " "
+                                  << std::setw(20) << benchmark["instance"].get<std::string>() << " "
+                                  << std::fixed << std::setprecision(3) << speedup << "x" << std::endl;
+                    }
+                }
+            }
+            if (compared > 0) {
+                report["geomean_speedup"] = std::exp(log_sum / compared);
+                std::cerr << "Geometric mean speedup: " << std::fixed << std::setprecision(3) << std::exp(log_sum / compared) << "x" << std::endl;
+            }
+        }
+
+        if (result.count("output")) {
+            std::ofstream report_out(result["output"].as<std::string>());
+            if (!report_out.is_open()) {
+                throw std::runtime_error("Error opening output file " + result["output"].as<std::string>() + " for writing.");
+            }
+            report_out << report.dump(2) << std::endl;
+        } else {
+            std::cout << report.dump(2) << std::endl;
+        }
+
+    } catch (const cxxopts::exceptions::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::cerr << options.help() << std::endl;
+        return EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    } catch (...) {
+        std::cerr << "Unknown error occurred." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
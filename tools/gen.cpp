@@ -0,0 +1,98 @@
+#include <generator.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cxxopts.hpp>
+
+
+int main(int argc, char** argv) {
+
+    // Parse command line arguments using cxxopts
+    cxxopts::Options options("mpp_gen", "Generate a synthetic instance of the maintenance planning problem (challenge format).");
+    options.add_options()
+        ("output", "Path to the output instance file (use - for the standard output).", cxxopts::value<std::string>())
+        ("periods", "Number of time periods (T).", cxxopts::value<int>()->default_value("100"))
+        ("interventions", "Number of interventions.", cxxopts::value<size_t>()->default_value("100"))
+        ("delta_min", "Minimum duration of an intervention.", cxxopts::value<int>()->default_value("1"))
+        ("delta_max", "Maximum duration of an intervention.", cxxopts::value<int>()->default_value("5"))
+        ("delta_variation", "Maximum change of the duration of an intervention between start times.", cxxopts::value<int>()->default_value("1"))
+        ("scenarios_min", "Minimum number of risk scenarios of a period.", cxxopts::value<int>()->default_value("10"))
+        ("scenarios_max", "Maximum number of risk scenarios of a period.", cxxopts::value<int>()->default_value("30"))
+        ("resources", "Number of resources.", cxxopts::value<size_t>()->default_value("3"))
+        ("resource_density", "Probability of an intervention having a workload on each resource.", cxxopts::value<double>()->default_value("0.5"))
+        ("resource_tightness", "Upper bound of a resource as a multiple of its average usage per period.", cxxopts::value<double>()->default_value("1.5"))
+        ("resource_lower", "Lower bound of a resource as a multiple of its average usage per period.", cxxopts::value<double>()->default_value("0.0"))
+        ("seasons", "Number of seasons.", cxxopts::value<size_t>()->default_value("3"))
+        ("exclusions", "Number of exclusions.", cxxopts::value<size_t>()->default_value("20"))
+        ("quantile", "Quantile of the risk.", cxxopts::value<double>()->default_value("0.95"))
+        ("alpha", "Weight of the mean risk in the objective.", cxxopts::value<double>()->default_value("0.5"))
+        ("seed", "Random seed.", cxxopts::value<unsigned long long int>()->default_value("0"))
+        ("h,help", "Show help message.");
+
+        options.parse_positional({"output"});
+        options.positional_help("<OUTPUT_FILE>");
+
+    try {
+
+        // Parse the command line arguments and show help if needed
+        auto result = options.parse(argc, argv);
+        if (result.count("help") || !result.count("output")) {
+            std::cout << options.help() << std::endl;
+            return result.count("help") ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        // Load the generator settings from command line arguments
+        mpp::generator_settings_t settings;
+        settings.T = result["periods"].as<int>();
+        settings.interventions = result["interventions"].as<size_t>();
+        settings.delta_min = result["delta_min"].as<int>();
+        settings.delta_max = result["delta_max"].as<int>();
+        settings.delta_variation = result["delta_variation"].as<int>();
+        settings.scenarios_min = result["scenarios_min"].as<int>();
+        settings.scenarios_max = result["scenarios_max"].as<int>();
+        settings.resources = result["resources"].as<size_t>();
+        settings.resource_density = result["resource_density"].as<double>();
+        settings.resource_tightness = result["resource_tightness"].as<double>();
+        settings.resource_lower = result["resource_lower"].as<double>();
+        settings.seasons = result["seasons"].as<size_t>();
+        settings.exclusions = result["exclusions"].as<size_t>();
+        settings.quantile = result["quantile"].as<double>();
+        settings.alpha = result["alpha"].as<double>();
+        settings.seed = result["seed"].as<unsigned long long int>();
+
+        // Write the instance (through a large buffer, as instances may have several GB)
+        const std::string output_file = result["output"].as<std::string>();
+        if (output_file == "-") {
+            mpp::generate_instance(settings, std::cout);
+        } else {
+            std::vector<char> buffer(1 << 22);
+            std::ofstream out;
+            out.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            out.open(output_file);
+            if (!out.is_open()) {
+                throw std::runtime_error("Error opening instance file " + output_file + " for writing.");
+            }
+            mpp::generate_instance(settings, out);
+            out.close();
+            if (out.fail()) {
+                throw std::runtime_error("Error writing instance file " + output_file + ".");
+            }
+        }
+
+    } catch (const cxxopts::exceptions::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::cerr << options.help() << std::endl;
+        return EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    } catch (...) {
+        std::cerr << "Unknown error occurred." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
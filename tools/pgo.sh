@@ -0,0 +1,48 @@
+#!/usr/bin/env bash
+#
+# Two-stage profile-guided (and link-time optimized) build:
+#   1. instrumented build (MPP_PGO=GENERATE);
+#   2. training run on synthetic instances (solver runs and micro-benchmarks);
+#   3. optimized build from the profiles (MPP_PGO=USE), in the same build directory.
+#
+# Usage: tools/pgo.sh [BUILD_DIR] [extra CMake arguments...]
+# Set MPP_NATIVE=ON in the environment to also build for the CPU of the build machine.
+
+set -euo pipefail
+
+SOURCE_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="${1:-${SOURCE_DIR}/build/pgo}"
+shift || true
+PROFILE_DIR="${BUILD_DIR}/pgo-profiles"
+TRAINING_DIR="${BUILD_DIR}/pgo-training"
+JOBS="$(nproc 2>/dev/null || echo 4)"
+
+CMAKE_ARGS=(-DCMAKE_BUILD_TYPE=Release -DMPP_ENABLE_LTO=ON -DMPP_NATIVE="${MPP_NATIVE:-OFF}" -DMPP_PGO_DIR="${PROFILE_DIR}" "$@")
+
+# 1. Instrumented build
+rm -rf "${PROFILE_DIR}" "${TRAINING_DIR}"
+cmake -S "${SOURCE_DIR}" -B "${BUILD_DIR}" "${CMAKE_ARGS[@]}" -DMPP_PGO=GENERATE
+cmake --build "${BUILD_DIR}" -j"${JOBS}"
+
+# 2. Training run: a small and a medium synthetic instance, solved with a fixed number of generations
+mkdir -p "${TRAINING_DIR}"
+"${BUILD_DIR}/mpp_gen" "${TRAINING_DIR}/small.json" --periods 50 --interventions 80 --seed 1
+"${BUILD_DIR}/mpp_gen" "${TRAINING_DIR}/medium.json" --periods 150 --interventions 300 --delta_max 8 --seed 2
+for instance in small medium; do
+    "${BUILD_DIR}/mpp" "${TRAINING_DIR}/${instance}.json" "${TRAINING_DIR}/${instance}.txt" \
+        --timelimit -1 --max_generations 200 --threads 2 --mip_timelimit 10 --lns_stall 0
+done
+"${BUILD_DIR}/mpp_bench" --min_time 0.2 --threads 2 --output "${TRAINING_DIR}/bench.json"
+
+# Clang writes raw profiles that must be merged
+if compgen -G "${PROFILE_DIR}/*.profraw" > /dev/null; then
+    llvm-profdata merge -output="${PROFILE_DIR}/default.profdata" "${PROFILE_DIR}"/*.profraw
+fi
+
+# 3. Optimized build
+cmake -S "${SOURCE_DIR}" -B "${BUILD_DIR}" "${CMAKE_ARGS[@]}" -DMPP_PGO=USE
+cmake --build "${BUILD_DIR}" -j"${JOBS}"
+
+echo "Optimized build in ${BUILD_DIR}. Compare it with a plain release build using:"
+echo "  <release build>/mpp_bench --output release.json"
+echo "  ${BUILD_DIR}/mpp_bench --baseline release.json"
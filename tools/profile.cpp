@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cxxopts.hpp>
+
+
+namespace {
+
+    /**
+     * @brief An improvement of the best solution of a run (a line of a convergence log).
+     */
+    struct improvement_t {
+        double time;
+        double violations;
+        double resource_sum;
+        double objective;
+    };
+
+
+    /**
+     * @brief Read a convergence log written with "mpp --convergence".
+     * @param filename Path to the CSV file.
+     * @return The improvements of the run, in the order of the file.
+     */
+    std::vector<improvement_t> read_log(const std::string& filename) {
+        std::ifstream in(filename);
+        if (!in.is_open()) {
+            throw std::runtime_error("Error opening convergence file " + filename + " for reading.");
+        }
+
+        // Columns, by name (the other ones, e.g. the source engine or the objective components, are not used)
+        auto split = [](const std::string& line) {
+            std::vector<std::string> fields;
+            std::stringstream ss(line);
+            std::string field;
+            while (std::getline(ss, field, ',')) fields.push_back(field);
+            return fields;
+        };
+
+        std::string line;
+        std::getline(in, line);
+        const std::vector<std::string> header = split(line);
+        auto column = [&](const std::string& name) {
+            auto it = std::find(header.begin(), header.end(), name);
+            if (it == header.end()) {
+                throw std::runtime_error("Missing column " + name + " in convergence file " + filename + ".");
+            }
+            return static_cast<size_t>(it - header.begin());
+        };
+        const size_t time = column("time");
+        const size_t violations = column("violations");
+        const size_t resource_sum = column("resource_sum");
+        const size_t objective = column("objective");
+
+        std::vector<improvement_t> log;
+        while (std::getline(in, line)) {
+            if (line.empty()) continue;
+            const std::vector<std::string> fields = split(line);
+            if (fields.size() != header.size()) {
+                throw std::runtime_error("Invalid line in convergence file " + filename + ": " + line);
+            }
+            log.push_back({std::stod(fields[time]), std::stod(fields[violations]), std::stod(fields[resource_sum]), std::stod(fields[objective])});
+        }
+        return log;
+    }
+
+
+    /**
+     * @brief Quantile of sorted values (linear interpolation between order statistics).
+     */
+    double quantile(const std::vector<double>& sorted, double q) {
+        const double position = q * (sorted.size() - 1);
+        const size_t k = static_cast<size_t>(std::floor(position));
+        if (k + 1 >= sorted.size()) return sorted.back();
+        return sorted[k] + (position - k) * (sorted[k + 1] - sorted[k]);
+    }
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+
+    // Parse command line arguments using cxxopts
+    cxxopts::Options options("mpp_profile", "Anytime profile of a set of runs (e.g., one per seed) from their convergence logs (mpp --convergence).");
+    options.add_options()
+        ("logs", "Paths to the convergence logs.", cxxopts::value< std::vector<std::string> >())
+        ("times", "Times (in seconds) at which the profile is computed.", cxxopts::value< std::vector<double> >())
+        ("points", "Number of times (log-spaced up to the last improvement), if --times is not given.", cxxopts::value<int>()->default_value("20"))
+        ("quantiles", "Quantiles of the objective reported at each time.", cxxopts::value< std::vector<double> >()->default_value("0.1,0.5,0.9"))
+        ("tolerance", "Tolerance of the resource constraints to consider a solution feasible.", cxxopts::value<double>()->default_value("1e-5"))
+        ("output", "Path to the output CSV file (use - for the standard output).", cxxopts::value<std::string>()->default_value("-"))
+        ("h,help", "Show help message.");
+
+        options.parse_positional({"logs"});
+        options.positional_help("<LOG_FILE>...");
+
+    try {
+
+        // Parse the command line arguments and show help if needed
+        auto result = options.parse(argc, argv);
+        if (result.count("help") || !result.count("logs")) {
+            std::cout << options.help() << std::endl;
+            return result.count("help") ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        const double tolerance = result["tolerance"].as<double>();
+        const auto quantiles = result["quantiles"].as< std::vector<double> >();
+        for (double q : quantiles) {
+            if (q < 0.0 || q > 1.0) throw std::invalid_argument("Quantiles must be in [0, 1].");
+        }
+
+        // Read the logs
+        std::vector< std::vector<improvement_t> > logs;
+        double first_time = std::numeric_limits<double>::max();
+        double last_time = 0.0;
+        for (const auto& filename : result["logs"].as< std::vector<std::string> >()) {
+            logs.push_back(read_log(filename));
+            for (const auto& improvement : logs.back()) {
+                first_time = std::min(first_time, improvement.time);
+                last_time = std::max(last_time, improvement.time);
+            }
+        }
+
+        // Times of the profile
+        std::vector<double> times;
+        if (result.count("times")) {
+            times = result["times"].as< std::vector<double> >();
+            std::sort(times.begin(), times.end());
+        } else {
+            const int points = std::max(1, result["points"].as<int>());
+            const double low = std::max(first_time, 1e-3);
+            const double high = std::max(last_time, low);
+            for (int k = 0; k < points; ++k) {
+                times.push_back(points > 1 ? low * std::pow(high / low, static_cast<double>(k) / (points - 1)) : high);
+            }
+        }
+
+        // Open the output
+        const std::string output_file = result["output"].as<std::string>();
+        std::ofstream file_out;
+        if (output_file != "-") {
+            file_out.open(output_file);
+            if (!file_out.is_open()) {
+                throw std::runtime_error("Error opening output file " + output_file + " for writing.");
+            }
+        }
+        std::ostream& out = (output_file != "-") ? file_out : std::cout;
+
+        out << "time,runs,with_solution,feasible,mean_objective";
+        for (double q : quantiles) out << ",q" << q << "_objective";
+        out << std::endl;
+        out << std::setprecision(12);
+
+        // Best solution of each run at each time: mean and quantiles of the objective over the feasible runs
+        for (double t : times) {
+            size_t with_solution = 0;
+            std::vector<double> objectives;
+            for (const auto& log : logs) {
+                const improvement_t* best = nullptr;
+                for (const auto& improvement : log) {
+                    if (improvement.time <= t) best = &improvement;
+                }
+                if (best == nullptr) continue;
+                ++with_solution;
+                if (best->violations == 0.0 && best->resource_sum <= tolerance) {
+                    objectives.push_back(best->objective);
+                }
+            }
+
+            out << t << "," << logs.size() << "," << with_solution << "," << objectives.size() << ",";
+            if (objectives.empty()) {
+                for (size_t k = 0; k < quantiles.size(); ++k) out << ",";
+                out << std::endl;
+                continue;
+            }
+
+            std::sort(objectives.begin(), objectives.end());
+            double mean = 0.0;
+            for (double objective : objectives) mean += objective;
+            out << mean / objectives.size();
+            for (double q : quantiles) out << "," << quantile(objectives, q);
+            out << std::endl;
+        }
+
+    } catch (const cxxopts::exceptions::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::cerr << options.help() << std::endl;
+        return EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    } catch (...) {
+        std::cerr << "Unknown error occurred." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}